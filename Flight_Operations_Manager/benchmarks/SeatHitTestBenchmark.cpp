@@ -0,0 +1,92 @@
+// This file contains the seat hit-test benchmark. It replays a hover sweep, the
+// pointer moving one scene unit at a time along every pixel row of the cabin, through
+// `SeatMapGeometry::seatAt` and through a scan of every seat rect (the hit test the
+// grid replaced), and reports nanoseconds per lookup for both.
+//
+// Usage: seat_hit_test_benchmark [sweeps]   (default 20)
+
+#include "gui/SeatMapGeometry.h"
+#include "models/Flight.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QTextStream>
+#include <QVector>
+
+namespace {
+    // Pre-grid hit test: first seat in layout order whose rect holds the point
+    int scanSeatAt(const SeatMapGeometry& geometry, const QPoint& point) {
+        const auto& seats = geometry.seats();
+        for (int i = 0; i < seats.size(); ++i) {
+            if (!seats[i].isAisle && seats[i].rect.contains(point)) return i;
+        }
+        return -1;
+    }
+
+    struct SweepResult {
+        qint64 lookups = 0;
+        qint64 hits = 0;
+        qint64 elapsedNs = 0;
+    };
+
+    template <typename HitTest>
+    SweepResult sweep(const QVector<QPoint>& path, int sweeps, HitTest hitTest) {
+        SweepResult result;
+        QElapsedTimer timer;
+        timer.start();
+        for (int s = 0; s < sweeps; ++s) {
+            for (const QPoint& point : path) {
+                if (hitTest(point) >= 0) ++result.hits;
+            }
+        }
+        result.elapsedNs = timer.nsecsElapsed();
+        result.lookups = static_cast<qint64>(path.size()) * sweeps;
+        return result;
+    }
+
+    void report(QTextStream& out, const char* path, const SweepResult& result) {
+        const double nsPerLookup = result.lookups > 0 ? double(result.elapsedNs) / result.lookups : 0.0;
+        out << path << ',' << result.lookups << ',' << result.hits << ','
+            << result.elapsedNs / 1000000 << ',' << QString::number(nsPerLookup, 'f', 1) << '\n';
+    }
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+
+    const QStringList args = app.arguments();
+    const int sweeps = args.size() > 1 && args[1].toInt() > 0 ? args[1].toInt() : 20;
+
+    const auto geometry = SeatMapGeometry::forAircraft(Flight::aircraftType());
+    if (!geometry) {
+        out << "No cabin geometry for " << Flight::aircraftType() << '\n';
+        return 1;
+    }
+
+    // Boustrophedon over a margin around the cabin, so misses are measured too
+    const QRect area = geometry->bounds().adjusted(-20, -20, 20, 20);
+    QVector<QPoint> path;
+    path.reserve(static_cast<qsizetype>(area.width()) * area.height());
+    for (int y = area.top(); y <= area.bottom(); ++y) {
+        if ((y - area.top()) % 2 == 0) {
+            for (int x = area.left(); x <= area.right(); ++x) path.append(QPoint(x, y));
+        } else {
+            for (int x = area.right(); x >= area.left(); --x) path.append(QPoint(x, y));
+        }
+    }
+
+    // The two must agree, or the comparison means nothing
+    for (const QPoint& point : path) {
+        if (geometry->seatAt(point) != scanSeatAt(*geometry, point)) {
+            out << "Grid and scan disagree at " << point.x() << ',' << point.y() << '\n';
+            return 1;
+        }
+    }
+
+    out << "seats," << geometry->size() << '\n';
+    out << "path,lookups,hits,ms,ns_per_lookup\n";
+    report(out, "grid", sweep(path, sweeps, [&](const QPoint& p) { return geometry->seatAt(p); }));
+    report(out, "scan", sweep(path, sweeps, [&](const QPoint& p) { return scanSeatAt(*geometry, p); }));
+    return 0;
+}
@@ -0,0 +1,226 @@
+// This file contains the SQLite write benchmark. It measures passenger rows per
+// second through the batched `SQLiteDatabase::savePassengers` path, through one
+// `savePassenger` call (and transaction) per row, and through a copy of the per-row
+// path as it was before batching (statements prepared per row, default rollback
+// journal), for 1k, 100k and 1M passengers by default, in throwaway databases
+// under a temporary directory.
+//
+// Usage: sqlite_write_benchmark [--per-row-limit N] [passenger counts...]
+// The per-row paths are only timed on the first N rows of a run (default 100000),
+// since a million single-row transactions takes much longer than the rate needs.
+
+#include "database/SQLiteDatabase.h"
+#include "models/Flight.h"
+#include "models/Passenger.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <memory>
+#include <vector>
+
+namespace {
+    constexpr qint64 kDefaultPerRowLimit = 100000;
+    constexpr int kFlightsPerSave = 256;
+    const char* const kLegacyConnection = "bench_legacy";
+
+    struct FlightSeats {
+        QString flightNumber;
+        QStringList seatNumbers;
+    };
+
+    // Creates enough empty flights to seat `passengers` people and returns their seats
+    std::vector<FlightSeats> createFlights(SQLiteDatabase& db, const QString& prefix, qint64 passengers) {
+        std::vector<FlightSeats> result;
+        std::vector<std::unique_ptr<Flight>> pending;
+        qint64 seated = 0;
+        const QDateTime departure = QDateTime::currentDateTime().addDays(1);
+        while (seated < passengers) {
+            auto flight = std::make_unique<Flight>(QString("%1%2").arg(prefix).arg(result.size()),
+                                                   "YYC", "YVR", departure);
+            FlightSeats seats{flight->getFlightNumber(), {}};
+            for (const Seat* seat : flight->getSeatsInLayoutOrder()) {
+                if (seated == passengers) break;
+                seats.seatNumbers << seat->getNumber();
+                ++seated;
+            }
+            result.push_back(std::move(seats));
+            pending.push_back(std::move(flight));
+            if (pending.size() == kFlightsPerSave || seated == passengers) {
+                std::vector<Flight*> batch;
+                for (const auto& f : pending) batch.push_back(f.get());
+                db.saveFlights(batch);
+                pending.clear();
+            }
+        }
+        return result;
+    }
+
+    std::vector<std::unique_ptr<Passenger>> makePassengers(const FlightSeats& flight) {
+        std::vector<std::unique_ptr<Passenger>> passengers;
+        passengers.reserve(static_cast<size_t>(flight.seatNumbers.size()));
+        for (const QString& seat : flight.seatNumbers) {
+            passengers.push_back(std::make_unique<Passenger>(
+                "Bench", "Passenger " + seat, "+1 403 555 0100", QString(), seat));
+        }
+        return passengers;
+    }
+
+    // Returns {rows written, elapsed ms}; passengers are built outside the timed region
+    std::pair<qint64, qint64> writeBatched(SQLiteDatabase& db, const std::vector<FlightSeats>& flights) {
+        qint64 rows = 0, elapsedNs = 0;
+        for (const FlightSeats& flight : flights) {
+            const auto passengers = makePassengers(flight);
+            std::vector<const Passenger*> batch;
+            for (const auto& p : passengers) batch.push_back(p.get());
+            QElapsedTimer timer;
+            timer.start();
+            if (db.savePassengers(flight.flightNumber, batch)) rows += static_cast<qint64>(batch.size());
+            elapsedNs += timer.nsecsElapsed();
+        }
+        return {rows, elapsedNs / 1000000};
+    }
+
+    std::pair<qint64, qint64> writePerRow(SQLiteDatabase& db, const std::vector<FlightSeats>& flights, qint64 limit) {
+        qint64 rows = 0, elapsedNs = 0;
+        for (const FlightSeats& flight : flights) {
+            if (rows >= limit) break;
+            const auto passengers = makePassengers(flight);
+            QElapsedTimer timer;
+            timer.start();
+            for (const auto& p : passengers) {
+                if (rows >= limit) break;
+                if (db.savePassenger(flight.flightNumber, *p)) ++rows;
+            }
+            elapsedNs += timer.nsecsElapsed();
+        }
+        return {rows, elapsedNs / 1000000};
+    }
+
+    // The per-row save as it stood before batching: a fresh prepare for every statement
+    // and a transaction per row, on a connection with SQLite's default journal
+    bool legacySavePassenger(QSqlDatabase& db, const QString& flightNumber, const Passenger& passenger) {
+        if (!db.transaction()) {
+            return false;
+        }
+
+        QSqlQuery query(db);
+        query.prepare("INSERT INTO passengers (flight_number, first_name, last_name, phone, email, seat_number) "
+                      "VALUES (?, ?, ?, ?, ?, ?)");
+        query.addBindValue(flightNumber);
+        query.addBindValue(passenger.getFirstName());
+        query.addBindValue(passenger.getLastName());
+        query.addBindValue(passenger.getPhoneNumber());
+        query.addBindValue(passenger.getEmail());
+        query.addBindValue(passenger.getSeatNumber());
+        bool ok = query.exec();
+
+        if (ok && passenger.hasSeat()) {
+            QSqlQuery seat(db);
+            seat.prepare("UPDATE seats SET status = ? WHERE flight_number = ? AND seat_number = ?");
+            seat.addBindValue(static_cast<int>(Seat::Status::Occupied));
+            seat.addBindValue(flightNumber);
+            seat.addBindValue(passenger.getSeatNumber());
+            ok = seat.exec() && seat.numRowsAffected() == 1;
+        }
+        if (!ok) {
+            db.rollback();
+            return false;
+        }
+        return db.commit();
+    }
+
+    std::pair<qint64, qint64> writeLegacyPerRow(const QString& path, const std::vector<FlightSeats>& flights, qint64 limit) {
+        qint64 rows = 0, elapsedNs = 0;
+        {
+            QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", kLegacyConnection);
+            db.setDatabaseName(path);
+            if (db.open()) {
+                // The copied file is in WAL mode; put it back on the journal the old code used
+                QSqlQuery(db).exec("PRAGMA journal_mode = DELETE");
+                QSqlQuery(db).exec("PRAGMA foreign_keys = ON");
+                for (const FlightSeats& flight : flights) {
+                    if (rows >= limit) break;
+                    const auto passengers = makePassengers(flight);
+                    QElapsedTimer timer;
+                    timer.start();
+                    for (const auto& p : passengers) {
+                        if (rows >= limit) break;
+                        if (legacySavePassenger(db, flight.flightNumber, *p)) ++rows;
+                    }
+                    elapsedNs += timer.nsecsElapsed();
+                }
+                db.close();
+            }
+        }
+        QSqlDatabase::removeDatabase(kLegacyConnection);
+        return {rows, elapsedNs / 1000000};
+    }
+
+    QString rate(qint64 rows, qint64 elapsedMs) {
+        return elapsedMs > 0 ? QString::number(rows * 1000.0 / elapsedMs, 'f', 0) : QString("-");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+
+    qint64 perRowLimit = kDefaultPerRowLimit;
+    QList<qint64> sizes;
+    const QStringList args = app.arguments().mid(1);
+    for (int i = 0; i < args.size(); ++i) {
+        if (args[i] == "--per-row-limit" && i + 1 < args.size()) {
+            perRowLimit = args[++i].toLongLong();
+        } else if (args[i].toLongLong() > 0) {
+            sizes << args[i].toLongLong();
+        }
+    }
+    if (sizes.isEmpty()) sizes = {1000, 100000, 1000000};
+
+    // The database lives in the working directory; keep it out of the user's
+    QTemporaryDir workDir;
+    if (!workDir.isValid() || !QDir::setCurrent(workDir.path())) {
+        out << "Cannot create a temporary directory\n";
+        return 1;
+    }
+    SQLiteDatabase& db = SQLiteDatabase::getInstance();
+    if (!db.connect()) {
+        out << "Cannot open the benchmark database\n";
+        return 1;
+    }
+
+    out << "passengers,path,rows,ms,rows_per_sec\n";
+    for (qint64 size : sizes) {
+        const auto batchedFlights = createFlights(db, QString("B%1-").arg(size), size);
+        const auto [batchedRows, batchedMs] = writeBatched(db, batchedFlights);
+        out << size << ",batched," << batchedRows << ',' << batchedMs << ',' << rate(batchedRows, batchedMs) << '\n';
+
+        const auto perRowFlights = createFlights(db, QString("R%1-").arg(size), qMin(size, perRowLimit));
+        const auto [perRowRows, perRowMs] = writePerRow(db, perRowFlights, perRowLimit);
+        out << size << ",per-row," << perRowRows << ',' << perRowMs << ',' << rate(perRowRows, perRowMs) << '\n';
+
+        // Baseline: the legacy path writes to its own copy of the database, taken while
+        // the writer is closed so the copy holds every committed row
+        const auto legacyFlights = createFlights(db, QString("L%1-").arg(size), qMin(size, perRowLimit));
+        const QString livePath = QDir::current().filePath("flightmanagement.db");
+        const QString legacyPath = QDir::current().filePath("legacy.db");
+        db.disconnect();
+        QFile::remove(legacyPath);
+        if (!QFile::copy(livePath, legacyPath) || !db.connect()) {
+            out << "Cannot prepare the legacy benchmark database\n";
+            return 1;
+        }
+        const auto [legacyRows, legacyMs] = writeLegacyPerRow(legacyPath, legacyFlights, perRowLimit);
+        out << size << ",per-row-legacy," << legacyRows << ',' << legacyMs << ',' << rate(legacyRows, legacyMs) << '\n';
+        out.flush();
+    }
+
+    db.disconnect();
+    return 0;
+}
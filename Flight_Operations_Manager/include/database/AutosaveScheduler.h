@@ -0,0 +1,100 @@
+// This header defines the `AutosaveScheduler` class, which writes the airline to a
+// recovery snapshot in the background. It follows the airline's `ChangeFeed`,
+// coalesces bursts of changes into one write after a quiet period (or after a
+// maximum delay during sustained activity), and only re-serializes the flights that
+// changed since the previous write.
+
+#ifndef AUTOSAVE_SCHEDULER_H
+#define AUTOSAVE_SCHEDULER_H
+
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <QSet>
+#include <QJsonObject>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include "models/ChangeFeed.h"
+
+class Airline;
+class OperationLog;
+class QTimer;
+
+class AutosaveScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    struct Metrics {
+        qint64 lastSaveMs = 0;       // Background write time of the last save
+        qint64 lastSnapshotMs = 0;   // UI-thread time spent preparing it
+        qint64 lastBytes = 0;
+        int lastCoalescedChanges = 0;
+        int savesCompleted = 0;
+        int savesFailed = 0;
+    };
+
+    AutosaveScheduler(Airline& airline, OperationLog* log, QObject* parent = nullptr);
+    ~AutosaveScheduler() override;
+
+    // `archivePath` receives the log records a running write covers; it is
+    // replayed before the live log during recovery and removed once the write lands
+    void setTarget(const QString& snapshotPath, const QString& archivePath);
+    void setDelays(int quietMs, int maxDelayMs);
+
+    void start();
+    void stop();
+    bool isSaving() const { return writer.isRunning(); }
+    // Blocks until a write in progress has finished
+    void waitForIdle();
+
+    Metrics metrics() const { return stats; }
+    // True while a lazy load leaves flights on disk that a snapshot would drop; the
+    // operation log covers changes meanwhile and the held-back write runs once lazy mode ends
+    bool isSuspended() const { return suspended; }
+
+signals:
+    void saved(qint64 durationMs, qint64 bytes, int coalescedChanges);
+    void saveFailed(const QString& path);
+    void suspendedChanged(bool suspended);
+
+private slots:
+    void poll();
+    void saveNow();
+    void writeFinished();
+
+private:
+    void setSuspended(bool value);
+
+    AutosaveScheduler(const AutosaveScheduler&) = delete;
+    AutosaveScheduler& operator=(const AutosaveScheduler&) = delete;
+
+    Airline& airline;
+    OperationLog* log;
+    ChangeFeed::Cursor cursor;
+    std::vector<ChangeEvent> events;
+
+    QString snapshotPath;
+    QString archivePath;
+    int quietMs = 2000;
+    int maxDelayMs = 30000;
+
+    QTimer* pollTimer;
+    QTimer* quietTimer;
+    QElapsedTimer burstTimer;   // Started by the first change after a write
+    QElapsedTimer saveTimer;
+    int pendingChanges = 0;
+    int writingChanges = 0;     // Changes covered by the write in progress
+    bool saveQueued = false;
+    bool suspended = false;
+
+    // Serialized flights from earlier saves; QJsonObject is implicitly shared, so the
+    // array handed to the writer thread is a copy-on-write snapshot of these
+    QHash<QString, QJsonObject> cache;
+    QSet<QString> staleFlights;
+    bool resyncAll = true;
+
+    QFutureWatcher<qint64> writer;
+    Metrics stats;
+};
+
+#endif // AUTOSAVE_SCHEDULER_H
@@ -0,0 +1,34 @@
+// This header defines the `ColumnarExporter` class, which writes flights, seats and
+// passengers as typed columns for analytics tools. Every column goes to its own file
+// so readers only scan what they need, and a manifest.json describes the tables.
+//
+// Column file layout (little endian):
+//   magic "FOMC", u16 version, u8 encoding, u8 reserved, u32 row count, payload
+//   Int64       row count x i64
+//   Float64     row count x f64
+//   Dictionary  u32 entry count, entries as (u32 byte length, UTF-8 bytes),
+//               u8 index width (1, 2 or 4), row count x index
+//   RunLength   u32 run count, runs as (u32 value, u32 length)
+
+#ifndef COLUMNAR_EXPORTER_H
+#define COLUMNAR_EXPORTER_H
+
+#include <QString>
+#include <memory>
+#include <vector>
+#include "models/Flight.h"
+
+class ColumnarExporter {
+public:
+    enum class Encoding : quint8 {
+        Int64 = 0,
+        Float64 = 1,
+        Dictionary = 2,
+        RunLength = 3
+    };
+
+    // Writes one file per column plus manifest.json into `directory`
+    static bool exportTo(const QString& directory, const std::vector<std::unique_ptr<Flight>>& flights);
+};
+
+#endif // COLUMNAR_EXPORTER_H
@@ -0,0 +1,84 @@
+// This header defines the `CompressedSnapshot` class, which reads and writes the
+// block-compressed `.fomz` save format. Flights are grouped into blocks that are
+// compressed independently with qCompress, so loading can inflate them in parallel,
+// and an index stored up front maps every flight to its block so that a single
+// flight can be read without touching the rest of the file.
+//
+// File layout (version 3):
+//   header   magic "FOMZ", format version, index size, block count
+//   index    qCompress'd string table holding every distinct string in the file
+//            per block: offset, compressed size, flight count
+//            per flight: number, origin, destination (string indexes), departure,
+//                        passenger count, block, position
+//   blocks   qCompress'd binary flight records whose strings are table indexes
+//
+// Version 1 and 2 files have no string table, store strings inline in the index
+// and compact JSON arrays in the blocks; version 1 also lacks the passenger count.
+// Strings read from a version 3 file are shared: every reference to the same
+// table entry is an implicitly shared copy of one QString.
+
+#ifndef COMPRESSED_SNAPSHOT_H
+#define COMPRESSED_SNAPSHOT_H
+
+#include <QString>
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <memory>
+#include <vector>
+#include "models/Flight.h"
+
+class CompressedSnapshot {
+public:
+    /**
+     * @brief Index entry describing one flight without decompressing it
+     */
+    struct FlightEntry {
+        QString flightNumber;
+        QString origin;
+        QString destination;
+        QDateTime departureTime;
+        quint32 passengerCount = 0;
+        quint32 block = 0;
+        quint32 position = 0;  // Position of the flight inside its block
+    };
+
+    static bool save(const QString& filename, const std::vector<std::unique_ptr<Flight>>& flights);
+    // True for files carrying the .fomz magic, whatever their name
+    static bool isCompressedFile(const QString& filename);
+
+    bool open(const QString& filename);
+    bool isOpen() const { return !path.isEmpty(); }
+    const std::vector<FlightEntry>& flights() const { return entries; }
+
+    bool loadAll(std::vector<std::unique_ptr<Flight>>& flights) const;
+    // Thread-safe; the last inflated block is kept so consecutive flights inflate it once
+    std::unique_ptr<Flight> loadFlight(const QString& flightNumber) const;
+    // Header-only flights for Airline's lazy loading mode
+    std::vector<std::unique_ptr<Flight>> loadHeaders() const;
+
+private:
+    struct BlockEntry {
+        quint64 offset = 0;  // Relative to the start of the block area
+        quint32 size = 0;
+        quint32 flightCount = 0;
+    };
+
+    QByteArray readBlock(quint32 block) const;
+    std::vector<std::unique_ptr<Flight>> inflateBlock(const QByteArray& compressed) const;
+
+    QString path;
+    quint16 version = 0;
+    QList<QString> strings;  // Version 3 string table
+    qint64 blockAreaOffset = 0;
+    std::vector<BlockEntry> blocks;
+    std::vector<FlightEntry> entries;
+    QHash<QString, int> entryByNumber;
+
+    mutable QMutex cacheMutex;
+    mutable qint64 cachedBlock = -1;
+    mutable std::vector<std::unique_ptr<Flight>> cachedFlights;
+};
+
+#endif // COMPRESSED_SNAPSHOT_H
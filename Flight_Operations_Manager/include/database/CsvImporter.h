@@ -0,0 +1,49 @@
+// This header defines the `CsvImporter` class, which bulk-loads passenger manifests
+// from CSV files into an `Airline`. The file is memory-mapped and split into chunks
+// that are parsed and validated in parallel; the accepted rows are then applied to
+// the airline as one batch per flight.
+
+#ifndef CSV_IMPORTER_H
+#define CSV_IMPORTER_H
+
+#include <QString>
+#include <vector>
+
+class Airline;
+
+/**
+ * @brief A rejected manifest row and the reason it was rejected
+ */
+struct CsvImportError {
+    qint64 line;       // 1-based physical line where the row starts
+    QString message;
+};
+
+/**
+ * @brief Outcome of a manifest import
+ */
+struct CsvImportResult {
+    qint64 rowsRead = 0;                  // Data rows, excluding the header and blank lines
+    qint64 rowsImported = 0;
+    qint64 elapsedMs = 0;
+    std::vector<CsvImportError> errors;   // Ordered by line number
+    QString fatalError;                   // Set when the file could not be imported at all
+
+    double rowsPerSecond() const {
+        return elapsedMs > 0 ? rowsRead * 1000.0 / elapsedMs : 0.0;
+    }
+};
+
+/**
+ * @brief The CsvImporter class imports passenger manifests from CSV
+ *
+ * The header row selects the columns by name ("Flight Number", "First Name",
+ * "Last Name" or "Passenger Name", "Phone", "Email", "Seat Number"). Files without
+ * a header are read in the column order written by Database::exportToCSV.
+ */
+class CsvImporter {
+public:
+    static CsvImportResult importManifest(const QString& filename, Airline& airline);
+};
+
+#endif // CSV_IMPORTER_H
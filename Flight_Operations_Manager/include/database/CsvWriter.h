@@ -0,0 +1,47 @@
+// This header defines the `CsvWriter` class, a row formatter that encodes fields
+// straight into a preallocated UTF-8 buffer with RFC 4180 quoting. It does no I/O
+// itself, so several writers can format independent chunks of a file in parallel
+// and the caller writes the finished buffers out in order.
+
+#ifndef CSV_WRITER_H
+#define CSV_WRITER_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QStringView>
+
+class CsvWriter {
+public:
+    explicit CsvWriter(qsizetype reserveBytes = 64 * 1024);
+
+    // Text fields are quoted only when they contain a comma, quote or line break
+    void addField(QStringView text);
+    // Two text values joined by a single space, e.g. first and last name
+    void addField(QStringView first, QStringView second);
+    void addField(qint64 value);
+    // Formatted as "yyyy-MM-dd hh:mm"; invalid dates produce an empty field
+    void addField(const QDateTime& value);
+    // Appends pre-encoded bytes verbatim as one field, e.g. a field reused across rows
+    void addRawField(const QByteArray& encoded);
+    void endRow();
+
+    // Encodes a single field once so it can be repeated with addRawField()
+    static QByteArray encodeField(QStringView text);
+
+    QByteArray takeData();
+    const char* constData() const { return buffer.constData(); }
+    qsizetype size() const { return used; }
+    void clear() { used = 0; atRowStart = true; }
+
+private:
+    char* reserve(qsizetype bytes);
+    void separator();
+    void appendUtf8(QStringView text);
+    static bool needsQuoting(QStringView text);
+
+    QByteArray buffer;
+    qsizetype used;
+    bool atRowStart;
+};
+
+#endif // CSV_WRITER_H
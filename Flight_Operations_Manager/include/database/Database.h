@@ -10,6 +10,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QStringList>
 #include <memory>
 #include <vector>
 #include "models/Flight.h"
@@ -21,11 +22,24 @@ public:
     static bool loadData(const QString& filename, std::vector<std::unique_ptr<Flight>>& flights);
     static bool exportToCSV(const QString& filename, const std::vector<std::unique_ptr<Flight>>& flights);
 
-private:
+    // Incremental saves: changed flights are appended as delta records to a
+    // journal beside the base snapshot and folded back in by compactJournal().
+    static bool saveDelta(const QString& filename, const std::vector<Flight*>& changedFlights,
+                          const QStringList& removedFlights);
+    static bool compactJournal(const QString& filename);
+    static qint64 journalSize(const QString& filename);
+    static QString journalPath(const QString& filename);
+
+    // JSON representation of a flight, shared with the compressed save format
     static QJsonObject flightToJson(const Flight* flight);
-    static QJsonObject passengerToJson(const Passenger* passenger);
     static std::unique_ptr<Flight> jsonToFlight(const QJsonObject& json);
+
+private:
+    static QByteArray flightToCsv(const Flight* flight);
+    static QJsonObject passengerToJson(const Passenger* passenger);
     static std::unique_ptr<Passenger> jsonToPassenger(const QJsonObject& json);
+    static QString compactingPath(const QString& filename);
+    static void applyJournal(const QString& path, QJsonArray& flightsArray);
 };
 
 #endif // DATABASE_H 
\ No newline at end of file
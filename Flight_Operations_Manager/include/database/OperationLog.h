@@ -0,0 +1,108 @@
+// This header defines the `OperationLog` class, an append-only write-ahead log of
+// booking operations. `Airline` records every successful mutation here so that the
+// operations made since the last snapshot can be replayed after a crash.
+
+#ifndef OPERATION_LOG_H
+#define OPERATION_LOG_H
+
+#include <QObject>
+#include <QFile>
+#include <QString>
+#include <QByteArray>
+#include <QDataStream>
+#include <vector>
+
+class Airline;
+class Flight;
+class Passenger;
+class QTimer;
+
+/**
+ * @brief Checksummed, group-committed log of Airline mutations
+ *
+ * Each record is framed as [length][crc32][payload]. Appends are handed to the
+ * operating system immediately, so an application crash loses nothing; the sync
+ * policy only decides how often the log is forced to stable storage.
+ */
+class OperationLog : public QObject {
+    Q_OBJECT
+
+public:
+    enum class SyncPolicy {
+        PerOperation,  // fsync after every record
+        Batched,       // fsync after every `batchSize` appends; a bulk import counts once
+        Timed          // fsync every `intervalMs` milliseconds
+    };
+
+    enum class Op : quint8 {
+        AddFlight = 1,
+        RemoveFlight,
+        UpdateFlight,
+        AddPassenger,
+        RemovePassenger,
+        BookSeat,
+        CancelBooking,
+        ChangeBooking,
+        AddPassengers
+    };
+
+    explicit OperationLog(QObject* parent = nullptr);
+    ~OperationLog() override;
+
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const { return file.isOpen(); }
+    bool reset();  // Drop all records once a snapshot covers them
+    // Moves the current records to the end of `archivePath` and empties the log, so a
+    // snapshot being written in the background covers the archive and not new records
+    bool rotate(const QString& archivePath);
+    bool sync();
+
+    void setSyncPolicy(SyncPolicy policy, int batchSize = 64, int intervalMs = 200);
+    SyncPolicy getSyncPolicy() const { return policy; }
+
+    // Recording (called by Airline after a mutation succeeds)
+    void logAddFlight(const Flight& flight);
+    void logRemoveFlight(const QString& flightNumber);
+    void logUpdateFlight(const QString& oldFlightNumber, const Flight& flight);
+    void logAddPassenger(const QString& flightNumber, const Passenger& passenger);
+    // Group commit for bulk imports: one write, and at most one sync, for the whole batch
+    void logAddPassengers(const QString& flightNumber, const std::vector<const Passenger*>& passengers);
+    void logRemovePassenger(const QString& flightNumber, const QString& passengerId);
+    void logBookSeat(const QString& flightNumber, const QString& passengerId, const QString& seatNumber);
+    void logCancelBooking(const QString& flightNumber, const QString& passengerId);
+    void logChangeBooking(const QString& flightNumber, const QString& passengerId, const QString& newSeatNumber);
+
+    // Applies every intact record in `path` to `airline`; returns the number applied
+    static int replay(const QString& path, Airline& airline);
+
+signals:
+    // A write or sync failed; the log has closed itself and records nothing more,
+    // so changes from here on would not survive a crash
+    void writeFailed(const QString& path);
+
+private:
+    template <typename... Args>
+    void record(Op op, const Args&... args) {
+        QByteArray payload;
+        QDataStream out(&payload, QIODevice::WriteOnly);
+        out << static_cast<quint8>(op);
+        (out << ... << args);
+        append(payload);
+    }
+
+    void append(const QByteArray& payload);
+    void appendFrames(const QByteArray& frames);
+    void fail(const char* operation);
+    static void frame(QByteArray& out, const QByteArray& payload);
+    static bool applyRecord(const QByteArray& payload, Airline& airline);
+    static qint64 validLength(const QByteArray& data, QList<QByteArray>* payloads = nullptr);
+
+    QFile file;
+    SyncPolicy policy;
+    int batchSize;
+    int unsyncedCount;
+    QTimer* syncTimer;
+};
+
+#endif // OPERATION_LOG_H
@@ -0,0 +1,58 @@
+// This header defines the `SQLiteConnectionManager` class, which hands out SQLite
+// connections in a way that respects Qt SQL's one-connection-per-thread rule:
+// every thread gets its own read-only WAL reader, and all writes are funnelled
+// through one connection living on a dedicated writer thread. Owners must call
+// close() before QCoreApplication goes away; the destructor does not close for them.
+
+#ifndef SQLITE_CONNECTION_MANAGER_H
+#define SQLITE_CONNECTION_MANAGER_H
+
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QSqlDatabase>
+#include <QThreadPool>
+#include <QThreadStorage>
+#include <atomic>
+#include <functional>
+
+class SQLiteConnectionManager {
+public:
+    explicit SQLiteConnectionManager(const QString& databasePath);
+    ~SQLiteConnectionManager();
+
+    bool open();
+    // Removes the writer and every thread's reader connection. Readers still in use on
+    // another thread are dropped by that thread on its next reader() call.
+    void close();
+    bool isOpen() const { return opened.load(); }
+
+    // Runs `work` on the writer thread with the writer connection and waits for the result.
+    // Writes are therefore serialized no matter which thread issues them.
+    bool write(const std::function<bool(QSqlDatabase&)>& work);
+
+    // Read-only connection owned by the calling thread; safe to use from worker threads
+    QSqlDatabase reader();
+
+private:
+    struct ReaderConnection {
+        QString name;
+        quint64 generation = 0;
+        ~ReaderConnection();
+    };
+
+    SQLiteConnectionManager(const SQLiteConnectionManager&) = delete;
+    SQLiteConnectionManager& operator=(const SQLiteConnectionManager&) = delete;
+
+    QString databasePath;
+    QString writerName;
+    QThreadPool writerThread;                 // Exactly one long-lived thread
+    QThreadStorage<ReaderConnection*> readers;
+    std::atomic<bool> opened{false};
+    std::atomic<quint64> generation{1};       // Bumped by close() to retire readers
+    std::atomic<quint64> readerSerial{0};     // Keeps reader names unique across generations
+    QMutex readersMutex;
+    QSet<QString> readerNames;                // Live reader connections, removed by close()
+};
+
+#endif // SQLITE_CONNECTION_MANAGER_H
@@ -3,11 +3,35 @@
 
 // This header defines the `SQLiteDatabase` class, an implementation of the abstract `Database` interface.
 // It provides functionalities for persisting and retrieving flight and passenger data
-// to and from an SQLite database file.
+// to and from an SQLite database file using a normalized flights/seats/passengers schema.
+// Writes are serialized through one writer connection; queries use a per-thread reader.
 
 #include <QString>
+#include <QStringList>
+#include <QDateTime>
+#include <QMap>
+#include <QHash>
 #include <QSqlDatabase>
 #include <QSqlQuery>
+#include <vector>
+#include "database/SQLiteConnectionManager.h"
+#include "models/Seat.h"
+
+class Airline;
+class Flight;
+class Passenger;
+
+/**
+ * @brief A passenger row as returned by SQL-side searches
+ */
+struct PassengerRecord {
+    QString flightNumber;
+    QString firstName;
+    QString lastName;
+    QString phoneNumber;
+    QString email;
+    QString seatNumber;
+};
 
 /**
  * @brief The SQLiteDatabase class handles SQLite database storage for the flight management system
@@ -16,18 +40,31 @@ class SQLiteDatabase {
 public:
     static SQLiteDatabase& getInstance();
     bool connect();
+    // Must be called while QCoreApplication is still alive; the destructor does not
     void disconnect();
     bool isConnected() const;
 
-    bool saveFlight(const QString& flightId, const QString& flightData);
-    bool updateFlight(const QString& flightId, const QString& flightData);
-    QString loadFlight(const QString& flightId);
-    bool deleteFlight(const QString& flightId);
+    // Whole-airline persistence
+    bool saveAirline(const Airline& airline);
+    bool loadAirline(Airline& airline);
+
+    // Row-level updates
+    bool saveFlight(const Flight& flight);
+    bool saveFlights(const std::vector<Flight*>& flights);  // One transaction
+    bool deleteFlight(const QString& flightNumber);
+    bool updateSeatStatus(const QString& flightNumber, const QString& seatNumber, Seat::Status status);
+    bool savePassenger(const QString& flightNumber, const Passenger& passenger);
+    bool savePassengers(const QString& flightNumber, const std::vector<const Passenger*>& passengers);  // One transaction
+    bool updatePassenger(const QString& flightNumber, const Passenger& passenger);  // Same upsert as savePassenger
+    bool deletePassenger(const QString& flightNumber, const QString& seatNumber);
 
-    bool savePassenger(const QString& passengerId, const QString& passengerData);
-    bool updatePassenger(const QString& passengerId, const QString& passengerData);
-    QString loadPassenger(const QString& passengerId);
-    bool deletePassenger(const QString& passengerId);
+    // Queries answered by SQLite instead of scanning the model; callable from any thread
+    QStringList searchFlights(const QString& query);
+    QStringList searchFlightsByRoute(const QString& origin, const QString& destination,
+                                     const QDateTime& from, const QDateTime& to);
+    std::vector<PassengerRecord> searchPassengers(const QString& query);
+    int occupiedSeatCount(const QString& flightNumber);
+    QMap<QString, int> occupancyByFlight();
 
 private:
     SQLiteDatabase();
@@ -35,9 +72,16 @@ private:
     SQLiteDatabase(const SQLiteDatabase&) = delete;
     SQLiteDatabase& operator=(const SQLiteDatabase&) = delete;
 
-    bool initTables();
-    QSqlDatabase db;
-    bool connected;
+    // Called on the writer thread with the writer connection
+    bool initTables(QSqlDatabase& db);
+    bool migrateLegacyTables(QSqlDatabase& db);
+    bool writeFlight(QSqlDatabase& db, const Flight& flight);
+    bool writePassengers(QSqlDatabase& db, const QString& flightNumber,
+                         const std::vector<const Passenger*>& passengers);
+    QSqlQuery& statement(QSqlDatabase& db, const char* sql);
+
+    SQLiteConnectionManager connections;
+    QHash<QString, QSqlQuery> statements;  // Writer's prepared statement cache, writer thread only
 };
 
-#endif // SQLITE_DATABASE_H 
\ No newline at end of file
+#endif // SQLITE_DATABASE_H
@@ -0,0 +1,33 @@
+// This header defines the `SeatStateCodec` class, the compact encoding of a flight's
+// complete seat state used by the save formats. Seats are listed in layout order
+// (`Flight::getSeatsInLayoutOrder`), so seat numbers are never stored.
+//
+//   status  varint seat count, then one nibble per seat (low nibble first):
+//           bits 0-1 the Seat::Status, bits 2-3 the seat's class index
+//   prices  varint class count, a zigzag varint base price per class in cents,
+//           then one varint per seat: its price in cents above its class base
+
+#ifndef SEAT_STATE_CODEC_H
+#define SEAT_STATE_CODEC_H
+
+#include <QByteArray>
+#include <vector>
+#include "models/Seat.h"
+
+class Flight;
+
+class SeatStateCodec {
+public:
+    struct Encoded {
+        QByteArray status;
+        QByteArray prices;
+        bool isEmpty() const { return status.isEmpty(); }
+    };
+
+    // Empty if the flight has more seat classes than the status nibble can index
+    static Encoded encode(const Flight& flight);
+    static bool decode(const QByteArray& status, const QByteArray& prices,
+                       std::vector<Seat::Status>& statuses, std::vector<double>& seatPrices);
+};
+
+#endif // SEAT_STATE_CODEC_H
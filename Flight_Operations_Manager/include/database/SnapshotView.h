@@ -0,0 +1,87 @@
+// This header defines the `SnapshotView` class, a read-only `FlightQuery` over a
+// memory-mapped binary report snapshot (`.fomb`). Queries read the fixed-size
+// records and the UTF-16 string table in place, so nothing is deserialized and
+// several processes mapping the same file share its pages.
+//
+// File layout (little endian, sections 8-byte aligned):
+//   header      magic "FOMB", version, counts and section offsets
+//   flights     fixed-size records sorted by flight number
+//   passengers  fixed-size records grouped by flight
+//   strings     UTF-16 code units; records refer to (offset, length) slices
+
+#ifndef SNAPSHOT_VIEW_H
+#define SNAPSHOT_VIEW_H
+
+#include <QFile>
+#include <QStringView>
+#include <memory>
+#include <vector>
+#include "models/FlightQuery.h"
+#include "models/Flight.h"
+
+class SnapshotView : public FlightQuery {
+public:
+    SnapshotView() = default;
+    ~SnapshotView() override;
+
+    static bool write(const QString& filename, const std::vector<std::unique_ptr<Flight>>& flights);
+
+    bool open(const QString& filename);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    int flightCount() const override;
+    std::vector<FlightSummary> allFlights() const override;
+    std::optional<FlightSummary> getFlight(const QString& flightNumber) const override;
+    std::vector<FlightSummary> searchFlights(const QString& query) const override;
+    std::vector<PassengerSummary> searchPassengers(const QString& query) const override;
+    std::vector<PassengerSummary> passengers(const QString& flightNumber) const override;
+    int occupiedSeats(const QString& flightNumber) const override;
+    double revenue(const QString& flightNumber) const override;
+
+    struct StringRef {
+        quint32 offset;
+        quint32 length;
+    };
+    struct FlightRecord {
+        StringRef flightNumber;
+        StringRef origin;
+        StringRef destination;
+        qint64 departureMsecs;  // UTC milliseconds since the epoch
+        double basePrice;
+        quint32 firstPassenger;
+        quint32 passengerCount;
+        quint32 occupiedSeats;
+        quint32 totalSeats;
+        double revenue;
+    };
+    struct PassengerRecord {
+        StringRef firstName;
+        StringRef lastName;
+        StringRef phoneNumber;
+        StringRef email;
+        StringRef seatNumber;
+        quint32 flight;
+        quint32 reserved;
+    };
+
+private:
+    SnapshotView(const SnapshotView&) = delete;
+    SnapshotView& operator=(const SnapshotView&) = delete;
+
+    QStringView text(StringRef ref) const;
+    const FlightRecord* findFlight(QStringView flightNumber) const;
+    FlightSummary summarize(const FlightRecord& record) const;
+    PassengerSummary summarize(const PassengerRecord& record) const;
+
+    QFile file;
+    const uchar* data = nullptr;
+    const FlightRecord* flightRecords = nullptr;
+    const PassengerRecord* passengerRecords = nullptr;
+    const char16_t* strings = nullptr;
+    quint32 flightTotal = 0;
+    quint32 passengerTotal = 0;
+    quint64 stringTotal = 0;
+};
+
+#endif // SNAPSHOT_VIEW_H
@@ -0,0 +1,55 @@
+// This header defines the `FlightListModel` class, the item model behind the main
+// window's flight list. Rows follow the Airline's flight order and are identified by
+// flight number; each row's display text is formatted the first time it is shown and
+// kept until that flight changes.
+
+#ifndef FLIGHTLISTMODEL_H
+#define FLIGHTLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <vector>
+#include "models/ChangeFeed.h"
+
+class Airline;
+class Flight;
+class QTimer;
+
+class FlightListModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    explicit FlightListModel(const Airline& airline, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    QString flightNumberAt(int row) const;
+    int rowOf(const QString& flightNumber) const;
+
+public slots:
+    // Applies pending change events; call right after mutating the airline
+    void sync();
+    void reload();
+
+private:
+    struct Row {
+        QString flightNumber;
+        mutable QString display;  // Empty until first shown
+    };
+
+    const Flight* flightAt(int row) const;
+    void reconcile();  // Brings the rows in line with the airline's flights
+    static QString format(const Flight& flight);
+
+    const Airline& airline;
+    ChangeFeed::Cursor cursor;
+    std::vector<ChangeEvent> events;
+    QTimer* pollTimer;
+    std::vector<Row> rows;
+    // Row of each flight number, rebuilt on first lookup after rows move
+    mutable QHash<QString, int> rowIndex;
+    mutable bool rowIndexValid = false;
+};
+
+#endif // FLIGHTLISTMODEL_H
@@ -0,0 +1,47 @@
+// This header defines the `FlightPrintRenderer` class, which renders printable seat
+// maps (PNG) and passenger manifests (PDF) for many flights without a window. Flights
+// are copied into plain snapshots on the calling thread and the pages are painted on
+// worker threads with the same seat drawing code as `SeatMapWidget`.
+
+#ifndef FLIGHTPRINTRENDERER_H
+#define FLIGHTPRINTRENDERER_H
+
+#include <QString>
+#include <QFuture>
+#include <QElapsedTimer>
+#include <QtGlobal>
+#include <memory>
+#include <vector>
+#include "models/Flight.h"
+
+class FlightPrintRenderer {
+public:
+    struct Result {
+        bool ok = false;      // Every file was written
+        int flights = 0;
+        int pages = 0;        // Seat map images plus manifest pages
+        qint64 elapsedMs = 0;
+
+        double pagesPerSecond() const { return elapsedMs > 0 ? pages * 1000.0 / elapsedMs : 0.0; }
+    };
+
+    // A render in progress. `future` yields one result per file, its page count or
+    // -1 on failure, and reports progress as files finish
+    struct Job {
+        QFuture<int> future;
+        int flights = 0;
+        int files = 0;
+        QElapsedTimer timer;
+
+        Result result() const;  // Once `future` has finished
+    };
+
+    // Writes <flight>-seatmap.png and <flight>-manifest.pdf for every flight into
+    // `directory`. Flights must be loaded; they are copied before this returns, so the
+    // airline may change while the job runs. Pages are painted on the thread pool, or
+    // on the calling thread before this returns where text cannot be rendered off the
+    // GUI thread
+    static Job start(const QString& directory, const std::vector<std::unique_ptr<Flight>>& flights);
+};
+
+#endif // FLIGHTPRINTRENDERER_H
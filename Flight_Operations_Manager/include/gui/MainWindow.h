@@ -7,6 +7,7 @@
 
 #include <QMainWindow>
 #include <QTimer>
+#include <QFuture>
 #include <memory>
 #include "models/Airline.h"
 #include "models/Flight.h"
@@ -17,6 +18,14 @@ QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
 
+class OperationLog;
+class AutosaveScheduler;
+class FlightQuery;
+class PassengerTableModel;
+class FlightListModel;
+class PassengerSearchModel;
+class QDialog;
+
 class MainWindow : public QMainWindow {
     Q_OBJECT
 
@@ -24,11 +33,20 @@ public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+protected:
+    void closeEvent(QCloseEvent* event) override;
+
 private slots:
     // File menu
     void on_actionSaveData_triggered();
+    void on_actionSaveChanges_triggered();
     void on_actionLoadData_triggered();
     void on_actionExportData_triggered();
+    void on_actionExportColumnar_triggered();
+    void on_actionExportReportSnapshot_triggered();
+    void on_actionRenderFlightSheets_triggered();
+    void on_actionSnapshotRevenueReport_triggered();
+    void on_actionImportManifest_triggered();
     
     // Flight menu
     void on_actionNewFlight_triggered();
@@ -40,6 +58,7 @@ private slots:
     void on_actionEditPassenger_triggered();
     void on_actionRemovePassenger_triggered();
     void on_actionSearchPassenger_triggered();
+    void on_actionShowAllPassengers_toggled(bool checked);
     
     // Booking menu
     void on_actionBookTicket_triggered();
@@ -61,12 +80,29 @@ private:
     Ui::MainWindow *ui;
     std::unique_ptr<Airline> airline;
     SeatMapWidget *seatMapWidget;
+    PassengerTableModel *passengerModel;
+    FlightListModel *flightModel;
+    QDialog *searchDialog = nullptr;        // Live passenger search, created on first use
+    PassengerSearchModel *searchModel = nullptr;
     QTimer *statusTimer;
+    QString currentDataFile;        // Base snapshot that incremental saves append to
+    QFuture<bool> compactionFuture;
+    OperationLog *operationLog;     // Crash-recovery log of bookings since the last checkpoint
+    AutosaveScheduler *autosave;    // Background recovery snapshots after bursts of changes
 
     void setupUI();
     void loadSettings();
     void saveSettings();
     void createStatusBar();
+    void compactJournalIfNeeded();
+    bool saveDataFile(const QString& filename);        // Picks the format from the suffix
+    bool loadDataFile(const QString& filename);        // Compressed files load lazily
+    void setupRecovery();
+    void setupAutosave();
+    void createSearchDialog();
+    void refreshSearch();  // After the flight set is replaced
+    void checkpointRecovery();
+    QString recoveryPath(const QString& fileName) const;
 
     // Helper methods
     void showError(const QString& message);
@@ -78,10 +114,12 @@ private:
     bool validatePassengerData(const QString& name, const QString& phone);
     bool validateBookingData(const QString& flightId, const QString& seatNo);
 
+    QString currentFlightNumber() const;
     Flight* getCurrentFlight() const;
     Passenger* getCurrentPassenger() const;
 
     void generateReport(const QString& title, const QString& content);
+    QString revenueReport(const FlightQuery& source) const;
 };
 
 #endif // MAINWINDOW_H
\ No newline at end of file
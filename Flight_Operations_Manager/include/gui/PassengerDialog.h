@@ -6,11 +6,15 @@
 
 #include <QDialog>
 #include <memory>
+#include <optional>
+#include <vector>
 #include <QMap>
 #include "models/Flight.h"
 #include "models/Passenger.h"
 #include "gui/SeatMapWidget.h"
 
+class QTimer;
+
 namespace Ui {
 class PassengerDialog;
 }
@@ -46,6 +50,7 @@ private slots:
     void validate();
     void onSeatSelected(const QString& seatNumber, double price, const QString& seatClass);
     void onTextChanged();
+    void pollFlightChanges();
 
 private:
     // UI components
@@ -56,6 +61,11 @@ private:
     Flight* m_flight;
     std::unique_ptr<Passenger> m_passenger;
     QMap<QString, QRect> m_seatMap;
+
+    // Keeps the seat map live: seat mutations on m_flight arrive through its change feed
+    std::optional<ChangeFeed::Cursor> m_feedCursor;
+    std::vector<ChangeEvent> m_feedEvents;
+    QTimer* m_feedTimer;
     
     // State
     QString m_selectedSeat;
@@ -71,6 +81,7 @@ private:
     bool validateFields() const;
     void updateSeatAvailability();
     void updateButtonStates();
+    void followFlightChanges();
     
     // Seat map helper functions
     int drawCabinSection(const QString& sectionName, 
@@ -0,0 +1,73 @@
+// This header defines the `PassengerSearchModel` class, the results model behind the
+// live passenger search. Keystrokes are debounced, each query runs on a worker thread
+// against a `PassengerSearchIndex` snapshot, a newer query cancels the one in flight,
+// and matches stream in as ranked batches while the scan continues.
+
+#ifndef PASSENGERSEARCHMODEL_H
+#define PASSENGERSEARCHMODEL_H
+
+#include <QAbstractTableModel>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <memory>
+#include <vector>
+#include "models/ChangeFeed.h"
+#include "models/PassengerSearchIndex.h"
+
+class Airline;
+class QTimer;
+
+class PassengerSearchModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column { FirstName, LastName, Phone, Seat, FlightNumber, ColumnCount };
+
+    explicit PassengerSearchModel(const Airline& airline, QObject* parent = nullptr);
+    ~PassengerSearchModel() override;
+
+    // Restarts the debounce; an empty query clears the results at once
+    void setQuery(const QString& query);
+    // Reruns the current query against the airline as it is now
+    void refresh();
+    bool isSearching() const { return watcher.isRunning(); }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    QString flightNumberAt(int row) const;
+    QString passengerIdAt(int row) const;
+
+signals:
+    // Latencies are measured from the last keystroke; firstResultMs is -1 without matches
+    void searchFinished(int matches, qint64 firstResultMs, qint64 totalMs);
+
+private slots:
+    void startSearch();
+    void batchesReady(int begin, int end);
+    void searchDone();
+
+private:
+    void cancel();
+    // Brings the snapshot up to the feed head, copying only flights changed since it was taken
+    void refreshSnapshot();
+
+    const Airline& airline;
+    QTimer* debounce;
+    QFutureWatcher<PassengerSearchIndex::Batch> watcher;
+    std::shared_ptr<const PassengerSearchIndex> snapshot;
+    ChangeFeed::Cursor cursor;
+    std::vector<ChangeEvent> events;
+
+    QString pendingQuery;
+    QElapsedTimer latency;  // Started by the keystroke that triggered the search
+    qint64 firstResultMs = -1;
+
+    // Entry indexes grouped by rank; rankEnd[r] is one past the last row of rank r
+    std::vector<quint32> rows;
+    int rankEnd[PassengerSearchIndex::RankCount] = {};
+};
+
+#endif // PASSENGERSEARCHMODEL_H
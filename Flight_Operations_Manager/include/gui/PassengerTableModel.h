@@ -0,0 +1,79 @@
+// This header defines the `PassengerTableModel` class, the item model behind the
+// main window's passenger table. Rows are read straight from each Flight's passenger
+// storage when the view asks for them; the model itself keeps only the passenger ids
+// (seat numbers) per row, which it diffs against the flights when change events
+// arrive so views get precise row insert/remove/change signals.
+
+#ifndef PASSENGERTABLEMODEL_H
+#define PASSENGERTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <vector>
+#include "models/ChangeFeed.h"
+
+class Airline;
+class Flight;
+class Passenger;
+class QTimer;
+
+class PassengerTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column { FirstName, LastName, Phone, Seat, FlightNumber };
+
+    explicit PassengerTableModel(const Airline& airline, QObject* parent = nullptr);
+
+    // One flight's passengers, or none for nullptr
+    void setFlight(Flight* flight);
+    // Every flight's passengers grouped by flight, with an extra flight column.
+    // Unloaded flights show no rows, so load them all first
+    void showAllFlights();
+    bool isAirlineWide() const { return airlineWide; }
+    Flight* flight() const { return airlineWide || blocks.empty() ? nullptr : blocks.front().flight; }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    // Selection maps to (flight number, passenger id), the key Airline's passenger API takes
+    Passenger* passengerAt(int row) const;
+    QString flightNumberAt(int row) const;
+    QString passengerIdAt(int row) const;
+    int rowOf(const QString& flightNumber, const QString& passengerId) const;
+
+public slots:
+    // Applies pending change events; call right after mutating the airline
+    void sync();
+
+private:
+    struct Block {
+        Flight* flight;
+        QString flightNumber;
+        std::vector<QString> ids;  // Seat numbers in storage order as of the last sync
+        int firstRow = 0;
+    };
+
+    void rebuild();
+    Block makeBlock(Flight* flight) const;
+    void syncBlock(int blockIndex);
+    void removeBlock(int blockIndex);
+    void insertBlock(int blockIndex, Flight* flight);
+    void updateOffsets(int fromBlock);
+    void reindexBlocks();
+    int blockForRow(int row) const;
+
+    const Airline& airline;
+    ChangeFeed::Cursor cursor;
+    std::vector<ChangeEvent> events;
+    QTimer* pollTimer;
+
+    bool airlineWide = false;
+    std::vector<Block> blocks;
+    QHash<QString, int> blockIndex;  // Flight number -> index into blocks
+    int totalRows = 0;
+};
+
+#endif // PASSENGERTABLEMODEL_H
@@ -0,0 +1,68 @@
+// This header defines the `SeatMapGeometry` class, the immutable visual layout of a
+// cabin: every seat's rectangle and class in layout order, an id lookup and a hit
+// test grid. Cabin geometries are computed once per aircraft type and shared by
+// every `SeatMapWidget`; per-flight state such as occupancy is kept separately.
+
+#ifndef SEATMAPGEOMETRY_H
+#define SEATMAPGEOMETRY_H
+
+#include <QHash>
+#include <QRect>
+#include <QString>
+#include <QVector>
+#include <memory>
+
+class Flight;
+
+// Per-flight state of one seat, aligned with SeatMapGeometry::seats()
+struct SeatState {
+    double price = 0.0;
+    bool occupied = false;
+};
+
+class SeatMapGeometry {
+public:
+    struct Seat {
+        QString seatId;
+        QString seatClass;
+        QRect rect;
+        bool isAisle = false;
+    };
+
+    // Shared geometry for an aircraft type, built on first use; nullptr for unknown types
+    static std::shared_ptr<const SeatMapGeometry> forAircraft(const QString& aircraftType);
+
+    explicit SeatMapGeometry(QVector<Seat> seats);
+
+    const QVector<Seat>& seats() const { return m_seats; }
+    int size() const { return static_cast<int>(m_seats.size()); }
+    int indexOf(const QString& seatId) const { return m_index.value(seatId, -1); }
+    // Index of the seat under a scene point, or -1
+    int seatAt(const QPoint& point) const;
+    // Union of all seat rects
+    QRect bounds() const { return m_bounds; }
+    // Size shared by most seats; the widget's sprite tiles are rendered at this size
+    QSize commonSeatSize() const { return m_commonSeatSize; }
+    // The flight's seat prices and occupancy in this geometry's order; seats the
+    // flight does not have stay default
+    QVector<SeatState> statesFor(const Flight& flight) const;
+
+private:
+    static std::shared_ptr<const SeatMapGeometry> buildCabin();
+    void buildHitGrid();
+
+    QVector<Seat> m_seats;
+    QHash<QString, int> m_index;
+    QRect m_bounds;
+    QSize m_commonSeatSize;
+
+    // Uniform grid over the seat rects; each cell lists the few seats overlapping
+    // it, so hit testing is a division and a short scan
+    QVector<QVector<int>> m_hitCells;  // Row-major; indexes into m_seats
+    int m_cellWidth = 1;
+    int m_cellHeight = 1;
+    int m_gridColumns = 0;
+    int m_gridRows = 0;
+};
+
+#endif // SEATMAPGEOMETRY_H
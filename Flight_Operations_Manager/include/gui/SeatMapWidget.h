@@ -15,8 +15,20 @@
 #include <QColor>
 #include <QWheelEvent>
 #include <QMouseEvent>
+#include <QHash>
+#include <QPixmap>
+#include <QFont>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <memory>
+#include "gui/SeatMapGeometry.h"
 
 class QGraphicsScene;
+class QTimer;
+
+// Per-frame paint, hit-test and legend timings; off by default, enable with
+// QT_LOGGING_RULES="fom.seatmap.perf.debug=true"
+Q_DECLARE_LOGGING_CATEGORY(lcSeatMapPerf)
 
 struct SeatVisualInfo {
     QString seatId;
@@ -36,15 +48,29 @@ struct SeatVisualInfo {
     bool isValid() const { return !seatId.isEmpty(); }
 };
 
+// One seat whose occupancy changed, as applied by SeatMapWidget::applyOccupancyChanges()
+struct SeatOccupancyChange {
+    QString seatId;
+    bool occupied = false;
+};
+
 class SeatMapWidget : public QGraphicsView {
     Q_OBJECT
 
 public:
     explicit SeatMapWidget(QWidget* parent = nullptr);
-    ~SeatMapWidget() override = default;
+    ~SeatMapWidget() override;
 
+    // Shows a shared cabin geometry with this flight's seat states. Passing the geometry
+    // already shown only re-applies the states, repainting seats whose state changed
+    void setSeatGeometry(std::shared_ptr<const SeatMapGeometry> geometry, const QVector<SeatState>& states);
+    std::shared_ptr<const SeatMapGeometry> seatGeometry() const { return m_geometry; }
+    // Builds a private geometry from freely placed seats
     void setSeatLayout(const QMap<QString, SeatVisualInfo>& seatInfoMap);
     void setOccupiedSeats(const QVector<QString>& occupied);
+    // Applies occupancy deltas; only seats whose state actually changes are repainted
+    void applyOccupancyChanges(const QVector<SeatOccupancyChange>& changes);
+    void setSeatOccupied(const QString& seatId, bool occupied);
     void setSeatPrices(const QMap<QString, double>& prices);
     void setFlightInfo(const QString& flightNumber, const QDateTime& departureTime, const QString& origin = "", const QString& destination = "");
     
@@ -52,12 +78,46 @@ public:
     void selectSeat(const QString& seatNumber);
     void clearSelection();
 
+    // Paint cost of the viewport, measured around every paintEvent
+    struct PaintStats {
+        quint64 frames = 0;
+        double lastMs = 0.0;
+        double averageMs = 0.0;
+        double worstMs = 0.0;
+    };
+    PaintStats paintStats() const;  // Read off the same samples as the overlay
+    void resetPaintStats() { m_paintSamples = RollingSamples(); }
+    // Sprites are on by default; turning them off paints every seat as vector
+    // shapes again, so both paths can be timed with paintStats()
+    void setSpriteRenderingEnabled(bool enabled);
+
+    // On-screen readout of paint time, seats drawn, hit-test time, hover frame rate and
+    // legend time. Toggled with Ctrl+Shift+P; seatMap/performanceOverlay turns it on at start
+    void setPerformanceOverlayEnabled(bool enabled);
+    bool isPerformanceOverlayEnabled() const { return m_overlayEnabled; }
+    // Appends p50/p90/p99/max of the recent samples as CSV under a run header, so
+    // several widgets and sessions share one file. The widget also does this when
+    // destroyed if seatMap/performanceExportFile names a file
+    bool exportPerformanceStats(const QString& path) const;
+
+    // Seat drawing shared with offscreen renderers; these touch no widget state and
+    // may be called from any thread
+    static QMap<QString, QColor> defaultClassColors();
+    static QFont seatLabelFont();
+    static void drawSeatShape(QPainter* painter, const SeatMapGeometry::Seat& seat,
+                              const QMap<QString, QColor>& colors, const QFont& labelFont,
+                              bool occupied, bool isSelected, bool isHovered, bool drawLabel = true);
+
 signals:
     void seatSelected(const QString& seatNumber, double price, const QString& seatClass);
     void seatHovered(const QString& seatNumber, double price, const QString& seatClass);
 
 protected:
+    // Seats in their resting state live in the cached background; the foreground
+    // only adds the selected and hovered seats on top
+    void drawBackground(QPainter* painter, const QRectF& rect) override;
     void drawForeground(QPainter* painter, const QRectF& rect) override;
+    void scrollContentsBy(int dx, int dy) override;
     void mouseMoveEvent(QMouseEvent* event) override;
     void mousePressEvent(QMouseEvent* event) override;
     void leaveEvent(QEvent* event) override;
@@ -65,18 +125,83 @@ protected:
     void paintEvent(QPaintEvent* event) override;
 
 private:
-    void drawSeat(QPainter* painter, const SeatVisualInfo& seatInfo, bool isSelected, bool isHovered);
+    // Pre-rendered seat tiles for one device pixel ratio: a row per seat class and a
+    // column per SpriteState, each tile the seat size plus the paint margin
+    enum SpriteState { Resting, Selected, Hovered, SelectedHovered, Occupied, SpriteStateCount };
+    struct SpriteAtlas {
+        QPixmap pixmap;
+        QSize seatSize;
+        int tileSize = 0;  // Logical pixels, square
+    };
+    struct Glyph {
+        QPixmap pixmap;
+        qreal advance = 0.0;
+    };
+
+    void paintSeat(QPainter* painter, const SeatMapGeometry::Seat& seat, bool occupied,
+                   bool isSelected, bool isHovered);
+    void drawSeat(QPainter* painter, const SeatMapGeometry::Seat& seat, bool occupied,
+                  bool isSelected, bool isHovered, bool drawLabel = true);
+    const SpriteAtlas& spriteAtlas(qreal devicePixelRatio);
+    const Glyph& glyph(QChar character, bool disabled, qreal devicePixelRatio);
+    void drawLabel(QPainter* painter, const QRect& rect, const QString& text, bool disabled, qreal devicePixelRatio);
+    void clearSpriteCaches();
     void setupClassColors();
-    QString seatAt(const QPointF& scenePos) const;
+    void invalidateSeat(const QString& seatId);
+    void invalidateSeats();  // After seat state held in the background cache changes
+    void invalidateSeatBackground(int index);
+    int seatAt(const QPointF& scenePos);  // Timed into the hit-test samples
     void drawLegend(QPainter* painter, int x, int y);
 
+    // The most recent samples of one metric, overwritten oldest first, plus totals
+    // over every sample since the last reset
+    struct RollingSamples {
+        QVector<double> values;
+        int next = 0;
+        quint64 count = 0;
+        double total = 0.0;
+        double worst = 0.0;
+
+        void add(double value);
+        double last() const { return values.isEmpty() ? 0.0 : values[(next + values.size() - 1) % values.size()]; }
+        double percentile(double fraction) const;
+    };
+    void recordFrame(double paintMs, double legendMs);
+    double hoverFramesPerSecond() const;
+    void drawPerformanceOverlay(QPainter* painter);
+
     QGraphicsScene* m_scene;
-    QMap<QString, SeatVisualInfo> m_seatInfoMap;
+    std::shared_ptr<const SeatMapGeometry> m_geometry;
+    QVector<SeatState> m_states;  // Aligned with m_geometry->seats()
     QMap<QString, QColor> m_classColors;
     
     // State
     QString m_selectedSeatId;
     QString m_hoveredSeatId;
+    QRect m_legendRect;  // Viewport coordinates of the last legend drawn
+
+    // Rendering caches
+    static const QStringList kSpriteClasses;
+    bool m_useSprites = true;
+    QSize m_spriteSeatSize;               // Seat size the atlases are rendered for
+    QHash<qreal, SpriteAtlas> m_atlases;  // Keyed by device pixel ratio
+    QHash<quint64, Glyph> m_glyphs;       // Keyed by character, text color and device pixel ratio
+    QFont m_seatFont;
+    qreal m_labelAscent = 0.0;
+    qreal m_labelHeight = 0.0;
+
+    // Performance overlay
+    bool m_overlayEnabled = false;
+    QRect m_overlayRect;  // Viewport coordinates of the last overlay drawn
+    QTimer* m_overlayTimer = nullptr;
+    QElapsedTimer m_perfClock;
+    int m_seatsDrawnThisFrame = 0;
+    QVector<qint64> m_hoverFrameTimes;  // m_perfClock times of frames in the last second of hover
+    RollingSamples m_paintSamples;
+    RollingSamples m_seatsDrawnSamples;
+    RollingSamples m_hitTestSamples;
+    RollingSamples m_hoverFpsSamples;
+    RollingSamples m_legendSamples;
 };
 
 #endif // SEATMAPWIDGET_H
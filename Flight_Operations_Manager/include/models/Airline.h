@@ -6,13 +6,26 @@
 #define AIRLINE_H
 
 #include <QString>
+#include <QStringList>
+#include <QSet>
+#include <QHash>
 #include <vector>
 #include <memory>
+#include <list>
+#include <functional>
 #include "models/Flight.h"
 #include "models/Passenger.h"
+#include "models/ChangeFeed.h"
+
+class OperationLog;
 
 class Airline {
 public:
+    // Produces the full flight for a header installed by a lazy load
+    using FlightLoader = std::function<std::unique_ptr<Flight>(const QString& flightNumber)>;
+    // Produces every flight at once, e.g. by inflating a whole file in parallel
+    using BulkLoader = std::function<bool(std::vector<std::unique_ptr<Flight>>& flights)>;
+
     explicit Airline(const QString& name);
 
     // Flight management
@@ -25,8 +38,15 @@ public:
 
     // Passenger management
     bool addPassenger(std::unique_ptr<Passenger> passenger, const QString& flightNumber);
+    // Batch form for bulk imports; returns the indexes of passengers that were rejected
+    std::vector<size_t> addPassengers(const QString& flightNumber,
+                                      std::vector<std::unique_ptr<Passenger>> passengers);
     bool removePassenger(const QString& passengerId, const QString& flightNumber);
+    // Replaces a passenger's details and seat; the original is restored if the new seat is taken
+    bool updatePassenger(const QString& passengerId, std::unique_ptr<Passenger> newPassenger,
+                         const QString& flightNumber);
     Passenger* getPassenger(const QString& passengerId, const QString& flightNumber) const;
+    // Both cover loaded flights only; in lazy mode call ensureAllLoaded() first
     std::vector<Passenger*> getAllPassengers() const;
     std::vector<Passenger*> searchPassengers(const QString& query) const;
 
@@ -43,9 +63,44 @@ public:
     bool isSeatValid(const QString& flightId, const QString& seatNumber) const;
     const std::vector<std::unique_ptr<Flight>>& getFlights() const;
 
+    // Dirty tracking for incremental saves
+    std::vector<Flight*> getDirtyFlights() const;
+    QStringList getRemovedFlights() const;
+    bool hasUnsavedChanges() const;
+    void markClean();
+
+    // Lazy loading: flights set as headers are materialized on first access through
+    // getFlight(), and at most `maxResident` clean flights stay materialized. The
+    // optional bulk loader serves ensureAllLoaded() when most flights are unloaded
+    void setFlightLoader(FlightLoader loader, size_t maxResident = 64, BulkLoader bulkLoader = nullptr);
+    bool isLazy() const { return static_cast<bool>(loader); }
+    bool hasUnloadedFlights() const;
+    // Materializes every flight and leaves lazy mode; call before whole-airline work
+    bool ensureAllLoaded();
+
+    // Write-ahead logging of mutations (not owned; nullptr disables logging)
+    void setOperationLog(OperationLog* log) { operationLog = log; }
+    OperationLog* getOperationLog() const { return operationLog; }
+
+    // Every flight, seat and passenger mutation is published here; observers
+    // subscribe a cursor instead of re-scanning the model
+    const ChangeFeed& changeFeed() const { return feed; }
+
 private:
     QString name;
     std::vector<std::unique_ptr<Flight>> flights;
+    QSet<QString> removedFlights;  // Removed since the last save
+    OperationLog* operationLog = nullptr;
+    mutable ChangeFeed feed;  // Mutable so lazy materialization can re-attach flights
+
+    bool materialize(Flight* flight) const;
+    void forgetResident(Flight* flight) const;
+
+    FlightLoader loader;
+    BulkLoader bulkLoader;
+    size_t maxResident = 64;
+    mutable std::list<Flight*> residentFlights;  // Most recently used first
+    mutable QHash<Flight*, std::list<Flight*>::iterator> residentIndex;
 };
 
 #endif // AIRLINE_H
@@ -0,0 +1,133 @@
+// This header defines the `ChangeFeed` class, an in-process stream of typed mutation
+// events published by `Airline` and `Flight`. Events are small POD records kept in
+// a fixed-size lock-free ring buffer; any number of consumers read it through their
+// own `ChangeFeed::Cursor` at their own pace. A consumer that falls more than the
+// ring's capacity behind is told it overran and must resynchronise from the model.
+
+#ifndef CHANGE_FEED_H
+#define CHANGE_FEED_H
+
+#include <QString>
+#include <QHash>
+#include <QReadWriteLock>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+class ChangeFeed;
+
+/**
+ * @brief An identifier carried by a ChangeEvent
+ *
+ * Short Latin-1 identifiers, which is nearly all of them, are stored inline so
+ * publishing them never allocates. Anything longer or outside Latin-1 is interned
+ * in the feed's string table and referenced by index, so ids are never truncated.
+ */
+template <size_t N>
+struct ChangeText {
+    char text[N];
+    quint32 interned;  // 0 when `text` holds the whole id, otherwise table index + 1
+};
+
+/**
+ * @brief One model mutation
+ */
+struct ChangeEvent {
+    enum class Type : quint8 {
+        FlightsReset,      // The whole flight set was replaced
+        FlightAdded,
+        FlightRemoved,
+        FlightUpdated,     // `detail` holds the previous flight number
+        FlightUnloaded,    // Evicted to a header; seats and passengers are gone until reloaded
+        SeatBooked,
+        SeatReleased,
+        SeatReserved,
+        SeatReservationCancelled,
+        SeatBlocked,
+        SeatUnblocked,
+        PassengerAdded,
+        PassengerRemoved,
+        PassengerEdited,   // `detail` holds the previous seat number
+        PassengersImported // A bulk import added many passengers to the flight at once
+    };
+
+    quint64 sequence;
+    Type type;
+    const ChangeFeed* feed;  // Resolves interned identifiers
+    ChangeText<16> flightNumber;
+    ChangeText<8> seatNumber;
+    ChangeText<16> detail;
+
+    QString flight() const;
+    QString seat() const;
+    QString detailText() const;
+};
+
+class ChangeFeed {
+public:
+    explicit ChangeFeed(size_t capacity = 4096);  // Rounded up to a power of two
+
+    void publish(ChangeEvent::Type type, const QString& flightNumber,
+                 const QString& seatNumber = QString(), const QString& detail = QString());
+
+    // Number of events published so far; the next event gets this sequence number
+    quint64 head() const { return claimed.load(std::memory_order_acquire); }
+    size_t capacity() const { return mask + 1; }
+
+    class Cursor {
+    public:
+        enum class Status { Ok, Overrun };
+
+        // Appends up to `maxEvents` new events to `out`. On Overrun the cursor skips
+        // to the oldest event still in the ring; events read before the gap are kept.
+        Status poll(std::vector<ChangeEvent>& out, size_t maxEvents = SIZE_MAX);
+        quint64 position() const { return next; }
+        quint64 pending() const { return feed->head() - next; }
+
+    private:
+        friend class ChangeFeed;
+        Cursor(const ChangeFeed* feed, quint64 start) : feed(feed), next(start) {}
+
+        const ChangeFeed* feed;
+        quint64 next;
+    };
+
+    // New cursors start at the current head and see only later events
+    Cursor subscribe() const { return Cursor(this, head()); }
+
+    // The full identifier behind an event field
+    template <size_t N>
+    QString text(const ChangeText<N>& field) const {
+        return field.interned ? internedText(field.interned - 1) : QString::fromLatin1(field.text);
+    }
+
+private:
+    struct Slot {
+        std::atomic<quint64> version{0};  // sequence + 1 once published, 0 while written
+        ChangeEvent event;
+    };
+
+    ChangeFeed(const ChangeFeed&) = delete;
+    ChangeFeed& operator=(const ChangeFeed&) = delete;
+
+    template <size_t N>
+    void store(ChangeText<N>& field, const QString& text);
+    quint32 intern(const QString& text);
+    QString internedText(quint32 index) const;
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    std::atomic<quint64> claimed{0};  // Producers reserve slots with fetch_add
+
+    // Append-only, so an index handed out stays valid for the feed's lifetime
+    mutable QReadWriteLock internLock;
+    QHash<QString, quint32> internIndex;
+    std::deque<QString> internTable;
+};
+
+inline QString ChangeEvent::flight() const { return feed->text(flightNumber); }
+inline QString ChangeEvent::seat() const { return feed->text(seatNumber); }
+inline QString ChangeEvent::detailText() const { return feed->text(detail); }
+
+#endif // CHANGE_FEED_H
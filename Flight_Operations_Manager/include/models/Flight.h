@@ -8,6 +8,7 @@
 
 #include <QString>
 #include <QDateTime>
+#include <QByteArrayView>
 #include <vector>
 #include <memory>
 #include <map>
@@ -15,6 +16,7 @@
 #include "models/Seat.h"
 #include "models/Passenger.h"
 #include "models/SeatLayout.h"
+#include "models/ChangeFeed.h"
 
 class Flight {
 public:
@@ -25,6 +27,29 @@ public:
            const QDateTime& departureTime,
            double basePrice = 500.0);
     ~Flight() = default;
+    Flight& operator=(Flight&& other) = default;
+
+    // Lazy loading: a header carries only the schedule and a passenger count until
+    // the full flight is moved into it; unload() turns a full flight back into one
+    static std::unique_ptr<Flight> createHeader(const QString& flightNumber,
+                                                const QString& origin,
+                                                const QString& destination,
+                                                const QDateTime& departureTime,
+                                                int passengerCount);
+    bool isLoaded() const { return loaded; }
+    void unload();
+
+    // Rebuilds a saved flight from per-seat state in layout order, keeping the saved
+    // prices and attaching passengers directly. Returns nullptr, leaving `passengers`
+    // untouched, if the state does not fit the layout
+    static std::unique_ptr<Flight> restore(const QString& flightNumber,
+                                           const QString& origin,
+                                           const QString& destination,
+                                           const QDateTime& departureTime,
+                                           double basePrice,
+                                           const std::vector<Seat::Status>& statuses,
+                                           const std::vector<double>& prices,
+                                           std::vector<std::unique_ptr<Passenger>>&& passengers);
 
     // Getters
     QString getFlightNumber() const { return flightNumber; }
@@ -41,6 +66,14 @@ public:
     bool isSeatAvailable(const QString& seatNumber) const;
     bool isSeatValid(const QString& seatNumber) const;
     bool isSeatOccupied(const QString& seatNumber) const;
+    // Checks a raw seat string such as "12A" against the cabin layout without allocating
+    static bool isLayoutSeat(QByteArrayView seatNumber);
+
+    // The cabin layout every flight is built on
+    static QString aircraftType();
+    static int layoutRowCount();
+    static QStringList layoutSeatLetters(int row);
+    static QString layoutSeatClass(int row);
 
     // Booking-related
     bool bookSeat(const std::string& seat, const std::string& passenger);
@@ -59,14 +92,19 @@ public:
 
     std::vector<QString> getAvailableSeats() const;
     int getOccupiedSeats() const;
+    int getPassengerCount() const { return loaded ? static_cast<int>(passengers.size()) : headerPassengerCount; }
     void displayPassengerInfo() const;
     std::vector<Passenger*> getPassengers() const;  // ✅ Added
 
     // Passenger management
     bool addPassenger(std::unique_ptr<Passenger> passenger);
+    void reservePassengers(size_t additional) { passengers.reserve(passengers.size() + additional); }
     bool removePassenger(const QString& seatNumber);
     Passenger* getPassenger(const QString& seatNumber) const;
     std::vector<Passenger*> getAllPassengers() const;
+    // Passenger storage in insertion order, for views that index it directly
+    size_t storedPassengerCount() const { return passengers.size(); }
+    Passenger* storedPassenger(size_t index) const { return passengers[index].get(); }
     void displaySeatMap() const;
     Seat* getSeat(const QString& seatNumber);
     QString generateSeatMap() const;
@@ -77,10 +115,27 @@ public:
     double calculateRevenue() const;
 
     const std::map<QString, std::unique_ptr<Seat>>& getSeats() const { return seats; }
+    // Row by row, seat letters left to right; the order saved seat state is kept in
+    std::vector<Seat*> getSeatsInLayoutOrder() const;
+
+    // Dirty tracking: set by every mutation, cleared once the flight is persisted
+    bool isDirty() const { return dirty; }
+    void markDirty() { dirty = true; }
+    void clearDirty() { dirty = false; }
+
+    // Seat and passenger mutations are published here (not owned; set by the Airline)
+    void setChangeFeed(ChangeFeed* feed) { changeFeed = feed; }
+    const ChangeFeed* getChangeFeed() const { return changeFeed; }
 
 private:
+    struct HeaderOnly {};
+    Flight(HeaderOnly, const QString& flightNumber, const QString& origin,
+           const QString& destination, const QDateTime& departureTime, int passengerCount);
+
     void initializeSeats();
+    void createSeats();  // Seats with their classes but no prices
     QString generateSeatNumber(int row, int col) const;
+    void publish(ChangeEvent::Type type, const QString& seatNumber) const;
 
     QString flightNumber;
     QString origin;
@@ -93,6 +148,10 @@ private:
     std::map<QString, std::unique_ptr<Seat>> seats;
     std::vector<std::unique_ptr<Passenger>> passengers;
     QVector<SeatRow> seatLayout;
+    bool dirty = true;  // New flights have never been saved
+    bool loaded = true;
+    int headerPassengerCount = 0;  // Passenger count known while only the header is loaded
+    ChangeFeed* changeFeed = nullptr;
 };
 
 #endif // FLIGHT_H
\ No newline at end of file
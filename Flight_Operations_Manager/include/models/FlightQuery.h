@@ -0,0 +1,79 @@
+// This header defines the `FlightQuery` interface, the read-only query surface shared
+// by the live `Airline` model and read-only snapshots. Reports written against it
+// can run on either source. `AirlineQuery` adapts an `Airline` to the interface.
+
+#ifndef FLIGHT_QUERY_H
+#define FLIGHT_QUERY_H
+
+#include <QString>
+#include <QDateTime>
+#include <optional>
+#include <vector>
+
+class Airline;
+
+/**
+ * @brief Flight header plus the figures reports need
+ */
+struct FlightSummary {
+    QString flightNumber;
+    QString origin;
+    QString destination;
+    QDateTime departureTime;
+    int passengerCount = 0;
+    int occupiedSeats = 0;
+    int totalSeats = 0;
+    double revenue = 0.0;
+};
+
+/**
+ * @brief A passenger together with the flight it is booked on
+ */
+struct PassengerSummary {
+    QString flightNumber;
+    QString firstName;
+    QString lastName;
+    QString phoneNumber;
+    QString email;
+    QString seatNumber;
+};
+
+class FlightQuery {
+public:
+    virtual ~FlightQuery() = default;
+
+    virtual int flightCount() const = 0;
+    virtual std::vector<FlightSummary> allFlights() const = 0;
+    virtual std::optional<FlightSummary> getFlight(const QString& flightNumber) const = 0;
+    // Case-insensitive match on flight number, origin or destination
+    virtual std::vector<FlightSummary> searchFlights(const QString& query) const = 0;
+    // Case-insensitive match on first or last name, exact substring on phone
+    virtual std::vector<PassengerSummary> searchPassengers(const QString& query) const = 0;
+    virtual std::vector<PassengerSummary> passengers(const QString& flightNumber) const = 0;
+    virtual int occupiedSeats(const QString& flightNumber) const = 0;
+    virtual double revenue(const QString& flightNumber) const = 0;
+};
+
+/**
+ * @brief FlightQuery over a live Airline
+ *
+ * Lazily loaded flights are materialized as queries reach them.
+ */
+class AirlineQuery : public FlightQuery {
+public:
+    explicit AirlineQuery(const Airline& airline) : airline(airline) {}
+
+    int flightCount() const override;
+    std::vector<FlightSummary> allFlights() const override;
+    std::optional<FlightSummary> getFlight(const QString& flightNumber) const override;
+    std::vector<FlightSummary> searchFlights(const QString& query) const override;
+    std::vector<PassengerSummary> searchPassengers(const QString& query) const override;
+    std::vector<PassengerSummary> passengers(const QString& flightNumber) const override;
+    int occupiedSeats(const QString& flightNumber) const override;
+    double revenue(const QString& flightNumber) const override;
+
+private:
+    const Airline& airline;
+};
+
+#endif // FLIGHT_QUERY_H
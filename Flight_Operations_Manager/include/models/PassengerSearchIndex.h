@@ -0,0 +1,88 @@
+// This header defines the `PassengerSearchIndex` class, an immutable snapshot of every
+// loaded passenger laid out for fast substring search off the GUI thread. Passenger
+// fields live back to back in one string arena per flight, so a million passengers
+// cost a few allocations per flight instead of millions of QString objects, and a
+// newer snapshot shares the arenas of every flight that has not changed since.
+
+#ifndef PASSENGER_SEARCH_INDEX_H
+#define PASSENGER_SEARCH_INDEX_H
+
+#include <QString>
+#include <QSet>
+#include <QList>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class Airline;
+class Flight;
+template <typename T> class QPromise;
+
+class PassengerSearchIndex {
+public:
+    // Lower ranks are listed first
+    enum Rank : quint8 { NamePrefix, NameSubstring, PhoneSubstring, RankCount };
+
+    struct Match {
+        quint32 entry;
+        Rank rank;
+    };
+    using Batch = QList<Match>;
+
+    // Copies the passengers of every loaded flight; must run on the thread that owns the Airline
+    static std::shared_ptr<const PassengerSearchIndex> build(const Airline& airline);
+    // Same result as build(), but only the flights in `changed` are copied again; the
+    // rest are shared with `previous`, which stays valid for searches still running on it
+    static std::shared_ptr<const PassengerSearchIndex> update(const Airline& airline,
+                                                              const PassengerSearchIndex& previous,
+                                                              const QSet<QString>& changed);
+
+    // Change feed head when the snapshot was taken; a different head means it is stale
+    quint64 feedPosition() const { return position; }
+    quint32 size() const { return firstEntry.empty() ? 0 : firstEntry.back(); }
+
+    QString firstName(quint32 entry) const;
+    QString lastName(quint32 entry) const;
+    QString phoneNumber(quint32 entry) const;
+    QString seatNumber(quint32 entry) const;
+    QString flightNumber(quint32 entry) const;
+
+    // Worker-thread search with the same matching rules as Airline::searchPassengers.
+    // Entries are scanned in chunks and each chunk's matches are reported as one batch,
+    // best rank first; stops early once the promise is canceled
+    void search(QPromise<Batch>& promise, const QString& query) const;
+
+private:
+    struct Entry {
+        quint32 start;   // Offset of the first name in the segment's arena
+        quint16 firstLength;
+        quint16 lastLength;
+        quint16 phoneLength;
+        quint16 seatLength;
+    };
+
+    // One flight's passengers, shared by successive snapshots until the flight changes
+    struct Segment {
+        QString flightNumber;
+        QString text;  // first, last, phone, seat for each entry, unseparated
+        std::vector<Entry> entries;
+
+        // Simple case folding keeps lengths, so folded offsets match `text`; built by the first search
+        mutable std::once_flag foldOnce;
+        mutable QString folded;
+
+        QString field(quint32 start, quint16 length) const { return text.mid(start, length); }
+        void fold() const;
+    };
+
+    static std::shared_ptr<const Segment> copyFlight(const Flight& flight);
+    void append(std::shared_ptr<const Segment> segment);
+    // The segment holding a snapshot-wide entry number, and the entry within it
+    std::pair<const Segment*, const Entry*> locate(quint32 entry) const;
+
+    quint64 position = 0;
+    std::vector<std::shared_ptr<const Segment>> segments;
+    std::vector<quint32> firstEntry;  // Entry number of each segment's first entry, plus the total
+};
+
+#endif // PASSENGER_SEARCH_INDEX_H
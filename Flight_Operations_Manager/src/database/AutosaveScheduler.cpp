@@ -0,0 +1,220 @@
+// This file contains the implementation for the `AutosaveScheduler` class.
+// Change events are drained on a short poll timer. Each write refreshes only the
+// cached JSON of flights named in those events, rotates the operation log so the
+// write covers exactly the archived records, and serializes the snapshot on a
+// worker thread behind a QSaveFile.
+
+#include "database/AutosaveScheduler.h"
+#include "database/Database.h"
+#include "database/OperationLog.h"
+#include "models/Airline.h"
+#include <QTimer>
+#include <QFile>
+#include <QSaveFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QDebug>
+#include <QtConcurrent/QtConcurrentRun>
+#include <utility>
+
+namespace {
+    constexpr int kPollIntervalMs = 250;
+}
+
+AutosaveScheduler::AutosaveScheduler(Airline& airline, OperationLog* log, QObject* parent)
+    : QObject(parent)
+    , airline(airline)
+    , log(log)
+    , cursor(airline.changeFeed().subscribe())
+    , pollTimer(new QTimer(this))
+    , quietTimer(new QTimer(this))
+{
+    quietTimer->setSingleShot(true);
+    connect(pollTimer, &QTimer::timeout, this, &AutosaveScheduler::poll);
+    connect(quietTimer, &QTimer::timeout, this, &AutosaveScheduler::saveNow);
+    connect(&writer, &QFutureWatcher<qint64>::finished, this, &AutosaveScheduler::writeFinished);
+}
+
+AutosaveScheduler::~AutosaveScheduler() {
+    waitForIdle();
+}
+
+void AutosaveScheduler::setTarget(const QString& newSnapshotPath, const QString& newArchivePath) {
+    snapshotPath = newSnapshotPath;
+    archivePath = newArchivePath;
+}
+
+void AutosaveScheduler::setDelays(int newQuietMs, int newMaxDelayMs) {
+    quietMs = qMax(0, newQuietMs);
+    maxDelayMs = qMax(quietMs, newMaxDelayMs);
+}
+
+void AutosaveScheduler::start() {
+    // Changes made while stopped are unknown, so the first write re-serializes everything
+    cursor = airline.changeFeed().subscribe();
+    resyncAll = true;
+    pollTimer->start(kPollIntervalMs);
+}
+
+void AutosaveScheduler::stop() {
+    pollTimer->stop();
+    quietTimer->stop();
+}
+
+void AutosaveScheduler::waitForIdle() {
+    writer.waitForFinished();
+}
+
+// -----------------------------------------------------------------------------
+// Change tracking
+// -----------------------------------------------------------------------------
+
+void AutosaveScheduler::poll() {
+    events.clear();
+    if (cursor.poll(events) == ChangeFeed::Cursor::Status::Overrun) {
+        // Lapped by the producers: which flights changed is lost, so rebuild them all
+        resyncAll = true;
+        ++pendingChanges;
+    }
+
+    int changes = static_cast<int>(events.size());
+    for (const ChangeEvent& event : events) {
+        switch (event.type) {
+        case ChangeEvent::Type::FlightsReset:
+            resyncAll = true;
+            break;
+        case ChangeEvent::Type::FlightUnloaded:
+            // Only clean flights are evicted; there is nothing to save
+            --changes;
+            break;
+        case ChangeEvent::Type::FlightRemoved:
+            cache.remove(event.flight());
+            break;
+        case ChangeEvent::Type::FlightUpdated:
+            cache.remove(event.detailText());
+            staleFlights.insert(event.flight());
+            break;
+        default:
+            staleFlights.insert(event.flight());
+            break;
+        }
+    }
+    pendingChanges += changes;
+    if (pendingChanges == 0) return;
+    if (suspended && !airline.isLazy()) {
+        // Everything is materialized now; write what was held back
+        saveNow();
+        return;
+    }
+
+    if (!burstTimer.isValid()) burstTimer.start();
+    if (events.empty()) return;  // Quiet since the last poll; let the timer run out
+
+    if (burstTimer.elapsed() >= maxDelayMs) {
+        saveNow();
+    } else {
+        quietTimer->start(quietMs);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Writing
+// -----------------------------------------------------------------------------
+
+void AutosaveScheduler::saveNow() {
+    quietTimer->stop();
+    if (pendingChanges == 0 || snapshotPath.isEmpty()) return;
+    if (writer.isRunning()) {
+        saveQueued = true;
+        return;
+    }
+    // Unloaded flights exist only in the lazily loaded file; the operation log keeps
+    // covering changes until everything is materialized
+    if (airline.hasUnloadedFlights()) {
+        setSuspended(true);
+        return;
+    }
+    setSuspended(false);
+
+    QElapsedTimer snapshotTimer;
+    snapshotTimer.start();
+
+    if (resyncAll) {
+        cache.clear();
+        staleFlights.clear();
+        for (const auto& flight : airline.getFlights())
+            cache.insert(flight->getFlightNumber(), Database::flightToJson(flight.get()));
+        resyncAll = false;
+    } else {
+        for (const QString& flightNumber : std::as_const(staleFlights)) {
+            if (const Flight* flight = airline.getFlight(flightNumber))
+                cache.insert(flightNumber, Database::flightToJson(flight));
+            else
+                cache.remove(flightNumber);
+        }
+        staleFlights.clear();
+    }
+
+    QJsonArray flightsArray;
+    for (const auto& flight : airline.getFlights()) {
+        auto it = cache.constFind(flight->getFlightNumber());
+        flightsArray.append(it != cache.constEnd() ? it.value() : Database::flightToJson(flight.get()));
+    }
+
+    // Records logged from here on are not in this snapshot and stay in the live log
+    if (log && log->isOpen() && !log->rotate(archivePath)) {
+        qWarning() << "Autosave could not rotate the operation log; skipping this write";
+        return;
+    }
+
+    writingChanges = pendingChanges;
+    pendingChanges = 0;
+    burstTimer.invalidate();
+    stats.lastSnapshotMs = snapshotTimer.elapsed();
+
+    const QString path = snapshotPath;
+    const QString archive = archivePath;
+    saveTimer.start();
+    writer.setFuture(QtConcurrent::run([flightsArray, path, archive]() -> qint64 {
+        QJsonObject root;
+        root["flights"] = flightsArray;
+        const QByteArray bytes = QJsonDocument(root).toJson();
+
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly) || file.write(bytes) != bytes.size() || !file.commit()) {
+            return -1;
+        }
+        QFile::remove(archive);
+        return bytes.size();
+    }));
+}
+
+void AutosaveScheduler::setSuspended(bool value) {
+    if (suspended == value) return;
+    suspended = value;
+    emit suspendedChanged(suspended);
+}
+
+void AutosaveScheduler::writeFinished() {
+    const qint64 bytes = writer.result();
+    if (bytes < 0) {
+        // The archive keeps the covered records; retry after the maximum delay
+        ++stats.savesFailed;
+        pendingChanges += writingChanges;
+        if (!burstTimer.isValid()) burstTimer.start();
+        quietTimer->start(maxDelayMs);
+        emit saveFailed(snapshotPath);
+    } else {
+        ++stats.savesCompleted;
+        stats.lastSaveMs = saveTimer.elapsed();
+        stats.lastBytes = bytes;
+        stats.lastCoalescedChanges = writingChanges;
+        emit saved(stats.lastSaveMs, bytes, writingChanges);
+    }
+    writingChanges = 0;
+
+    if (saveQueued) {
+        saveQueued = false;
+        if (!quietTimer->isActive()) quietTimer->start(quietMs);
+    }
+}
@@ -0,0 +1,254 @@
+// This file contains the implementation for the `ColumnarExporter` class.
+// Each column is gathered, encoded and written by its own job on the global
+// thread pool; the model is only read, so the jobs need no synchronisation.
+
+#include "database/ColumnarExporter.h"
+#include <QDir>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtConcurrent/QtConcurrentMap>
+#include <functional>
+
+namespace {
+    constexpr char kMagic[4] = {'F', 'O', 'M', 'C'};
+    constexpr quint16 kFormatVersion = 1;
+
+    using Encoding = ColumnarExporter::Encoding;
+    using Flights = std::vector<std::unique_ptr<Flight>>;
+
+    QString encodingName(Encoding encoding) {
+        switch (encoding) {
+            case Encoding::Int64: return "int64";
+            case Encoding::Float64: return "float64";
+            case Encoding::Dictionary: return "dictionary";
+            case Encoding::RunLength: return "rle";
+        }
+        return {};
+    }
+
+    /**
+     * @brief Accumulates one encoded column in memory
+     */
+    class ColumnBuffer {
+    public:
+        explicit ColumnBuffer(Encoding encoding) : encoding(encoding), out(&payload, QIODevice::WriteOnly) {
+            out.setByteOrder(QDataStream::LittleEndian);
+            out.setFloatingPointPrecision(QDataStream::DoublePrecision);
+        }
+
+        void addInt(qint64 value) { out << value; ++rows; }
+        void addDouble(double value) { out << value; ++rows; }
+
+        void addString(const QString& value) {
+            auto it = dictionary.constFind(value);
+            if (it == dictionary.constEnd()) {
+                it = dictionary.insert(value, static_cast<quint32>(entries.size()));
+                entries.push_back(value);
+            }
+            indices.push_back(it.value());
+            ++rows;
+        }
+
+        void addRun(quint32 value) {
+            if (!runs.empty() && runs.back().first == value) {
+                ++runs.back().second;
+            } else {
+                runs.push_back({value, 1});
+            }
+            ++rows;
+        }
+
+        QByteArray finish() {
+            if (encoding == Encoding::Dictionary) {
+                out << static_cast<quint32>(entries.size());
+                for (const QString& entry : entries) {
+                    const QByteArray utf8 = entry.toUtf8();
+                    out << static_cast<quint32>(utf8.size());
+                    out.writeRawData(utf8.constData(), utf8.size());
+                }
+                // Narrowest index type that can address the dictionary
+                const quint8 width = entries.size() <= 0xFF ? 1 : entries.size() <= 0xFFFF ? 2 : 4;
+                out << width;
+                for (quint32 index : indices) {
+                    if (width == 1) out << static_cast<quint8>(index);
+                    else if (width == 2) out << static_cast<quint16>(index);
+                    else out << index;
+                }
+            } else if (encoding == Encoding::RunLength) {
+                out << static_cast<quint32>(runs.size());
+                for (const auto& [value, length] : runs) {
+                    out << value << length;
+                }
+            }
+
+            QByteArray file;
+            QDataStream header(&file, QIODevice::WriteOnly);
+            header.setByteOrder(QDataStream::LittleEndian);
+            header.writeRawData(kMagic, sizeof(kMagic));
+            header << kFormatVersion << static_cast<quint8>(encoding) << quint8(0) << rows;
+            file.append(payload);
+            return file;
+        }
+
+    private:
+        Encoding encoding;
+        QByteArray payload;
+        QDataStream out;
+        quint32 rows = 0;
+        QHash<QString, quint32> dictionary;
+        std::vector<QString> entries;
+        std::vector<quint32> indices;
+        std::vector<std::pair<quint32, quint32>> runs;
+    };
+
+    struct ColumnJob {
+        QString table;
+        QString name;
+        Encoding encoding;
+        std::function<void(const Flights&, ColumnBuffer&)> gather;
+    };
+
+    template <typename Fn>
+    void forEachSeat(const Flights& flights, Fn fn) {
+        for (size_t i = 0; i < flights.size(); ++i) {
+            for (const auto& [seatNumber, seat] : flights[i]->getSeats()) {
+                fn(static_cast<quint32>(i), seatNumber, *seat);
+            }
+        }
+    }
+
+    template <typename Fn>
+    void forEachPassenger(const Flights& flights, Fn fn) {
+        for (size_t i = 0; i < flights.size(); ++i) {
+            for (const Passenger* passenger : flights[i]->getAllPassengers()) {
+                fn(static_cast<quint32>(i), *passenger);
+            }
+        }
+    }
+
+    std::vector<ColumnJob> columnJobs() {
+        return {
+            {"flights", "flight_number", Encoding::Dictionary, [](const Flights& flights, ColumnBuffer& column) {
+                for (const auto& flight : flights) column.addString(flight->getFlightNumber());
+            }},
+            {"flights", "origin", Encoding::Dictionary, [](const Flights& flights, ColumnBuffer& column) {
+                for (const auto& flight : flights) column.addString(flight->getOrigin());
+            }},
+            {"flights", "destination", Encoding::Dictionary, [](const Flights& flights, ColumnBuffer& column) {
+                for (const auto& flight : flights) column.addString(flight->getDestination());
+            }},
+            {"flights", "route_id", Encoding::Int64, [](const Flights& flights, ColumnBuffer& column) {
+                // Routes are numbered in order of first appearance
+                QHash<QString, qint64> routes;
+                for (const auto& flight : flights) {
+                    const QString route = flight->getOrigin() + QLatin1Char('\n') + flight->getDestination();
+                    auto it = routes.constFind(route);
+                    if (it == routes.constEnd()) it = routes.insert(route, routes.size());
+                    column.addInt(it.value());
+                }
+            }},
+            {"flights", "departure_epoch", Encoding::Int64, [](const Flights& flights, ColumnBuffer& column) {
+                for (const auto& flight : flights) column.addInt(flight->getDepartureTime().toSecsSinceEpoch());
+            }},
+            {"flights", "base_price", Encoding::Float64, [](const Flights& flights, ColumnBuffer& column) {
+                for (const auto& flight : flights) column.addDouble(flight->getBasePrice());
+            }},
+
+            {"seats", "flight_index", Encoding::RunLength, [](const Flights& flights, ColumnBuffer& column) {
+                forEachSeat(flights, [&](quint32 flight, const QString&, const Seat&) { column.addRun(flight); });
+            }},
+            {"seats", "seat_number", Encoding::Dictionary, [](const Flights& flights, ColumnBuffer& column) {
+                forEachSeat(flights, [&](quint32, const QString& seatNumber, const Seat&) { column.addString(seatNumber); });
+            }},
+            {"seats", "seat_class", Encoding::Dictionary, [](const Flights& flights, ColumnBuffer& column) {
+                forEachSeat(flights, [&](quint32, const QString&, const Seat& seat) { column.addString(seat.getSeatClass()); });
+            }},
+            {"seats", "price", Encoding::Float64, [](const Flights& flights, ColumnBuffer& column) {
+                forEachSeat(flights, [&](quint32, const QString&, const Seat& seat) { column.addDouble(seat.getPrice()); });
+            }},
+            {"seats", "status", Encoding::RunLength, [](const Flights& flights, ColumnBuffer& column) {
+                forEachSeat(flights, [&](quint32, const QString&, const Seat& seat) {
+                    column.addRun(static_cast<quint32>(seat.getStatus()));
+                });
+            }},
+
+            {"passengers", "flight_index", Encoding::RunLength, [](const Flights& flights, ColumnBuffer& column) {
+                forEachPassenger(flights, [&](quint32 flight, const Passenger&) { column.addRun(flight); });
+            }},
+            {"passengers", "first_name", Encoding::Dictionary, [](const Flights& flights, ColumnBuffer& column) {
+                forEachPassenger(flights, [&](quint32, const Passenger& p) { column.addString(p.getFirstName()); });
+            }},
+            {"passengers", "last_name", Encoding::Dictionary, [](const Flights& flights, ColumnBuffer& column) {
+                forEachPassenger(flights, [&](quint32, const Passenger& p) { column.addString(p.getLastName()); });
+            }},
+            {"passengers", "phone", Encoding::Dictionary, [](const Flights& flights, ColumnBuffer& column) {
+                forEachPassenger(flights, [&](quint32, const Passenger& p) { column.addString(p.getPhoneNumber()); });
+            }},
+            {"passengers", "email", Encoding::Dictionary, [](const Flights& flights, ColumnBuffer& column) {
+                forEachPassenger(flights, [&](quint32, const Passenger& p) { column.addString(p.getEmail()); });
+            }},
+            {"passengers", "seat_number", Encoding::Dictionary, [](const Flights& flights, ColumnBuffer& column) {
+                forEachPassenger(flights, [&](quint32, const Passenger& p) { column.addString(p.getSeatNumber()); });
+            }},
+        };
+    }
+
+    QString columnFileName(const ColumnJob& job) {
+        return job.table + "." + job.name + ".col";
+    }
+}
+
+bool ColumnarExporter::exportTo(const QString& directory, const std::vector<std::unique_ptr<Flight>>& flights) {
+    QDir dir(directory);
+    if (!dir.mkpath(".")) {
+        return false;
+    }
+
+    const std::vector<ColumnJob> jobs = columnJobs();
+    const QList<bool> written = QtConcurrent::blockingMapped<QList<bool>>(jobs, [&](const ColumnJob& job) {
+        ColumnBuffer column(job.encoding);
+        job.gather(flights, column);
+        QSaveFile file(dir.filePath(columnFileName(job)));
+        if (!file.open(QIODevice::WriteOnly)) return false;
+        file.write(column.finish());
+        return file.commit();
+    });
+    if (written.contains(false)) {
+        return false;
+    }
+
+    qint64 seatCount = 0, passengerCount = 0;
+    for (const auto& flight : flights) {
+        seatCount += static_cast<qint64>(flight->getSeats().size());
+        passengerCount += static_cast<qint64>(flight->getAllPassengers().size());
+    }
+    const QHash<QString, qint64> rowCounts = {
+        {"flights", static_cast<qint64>(flights.size())}, {"seats", seatCount}, {"passengers", passengerCount}
+    };
+
+    QJsonObject tables;
+    for (const ColumnJob& job : jobs) {
+        QJsonObject table = tables[job.table].toObject();
+        table["rows"] = rowCounts.value(job.table);
+        QJsonArray columns = table["columns"].toArray();
+        columns.append(QJsonObject{
+            {"name", job.name}, {"file", columnFileName(job)}, {"encoding", encodingName(job.encoding)}
+        });
+        table["columns"] = columns;
+        tables[job.table] = table;
+    }
+    QJsonObject manifest;
+    manifest["version"] = kFormatVersion;
+    manifest["tables"] = tables;
+
+    QSaveFile file(dir.filePath("manifest.json"));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(QJsonDocument(manifest).toJson());
+    return file.commit();
+}
@@ -0,0 +1,406 @@
+// This file contains the implementation for the `CompressedSnapshot` class.
+// Blocks are compressed and inflated on the global thread pool. The string table is
+// built in one pass before the blocks, so block encoding only reads it and can run
+// in parallel; older files with JSON blocks are inflated through `Database`.
+
+#include "database/CompressedSnapshot.h"
+#include "database/Database.h"
+#include "database/SeatStateCodec.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QtConcurrent/QtConcurrentMap>
+#include <numeric>
+
+namespace {
+    constexpr char kMagic[4] = {'F', 'O', 'M', 'Z'};
+    constexpr quint16 kFormatVersion = 3;
+    constexpr quint16 kFirstStringTableVersion = 3;
+    constexpr qint64 kHeaderSize = 16;
+    // Small enough that seeking to one flight inflates little, large enough to compress well
+    constexpr size_t kFlightsPerBlock = 16;
+    constexpr int kCompressionLevel = 6;
+
+    QDataStream& configure(QDataStream& stream) {
+        stream.setVersion(QDataStream::Qt_6_0);
+        return stream;
+    }
+
+    /**
+     * @brief Assigns each distinct string one index, in first-seen order
+     */
+    class StringTableBuilder {
+    public:
+        void add(const QString& value) {
+            if (!indexes.contains(value)) {
+                indexes.insert(value, static_cast<quint32>(values.size()));
+                values.append(value);
+            }
+        }
+        quint32 indexOf(const QString& value) const { return indexes.value(value); }
+        const QStringList& strings() const { return values; }
+
+    private:
+        QHash<QString, quint32> indexes;
+        QStringList values;
+    };
+
+    void addStrings(StringTableBuilder& table, const Flight& flight) {
+        table.add(flight.getFlightNumber());
+        table.add(flight.getOrigin());
+        table.add(flight.getDestination());
+        for (const Passenger* passenger : flight.getAllPassengers()) {
+            table.add(passenger->getFirstName());
+            table.add(passenger->getLastName());
+            table.add(passenger->getPhoneNumber());
+            table.add(passenger->getEmail());
+            table.add(passenger->getSeatNumber());
+        }
+    }
+
+    void writeFlight(QDataStream& out, const Flight& flight, const StringTableBuilder& table) {
+        const SeatStateCodec::Encoded seatState = SeatStateCodec::encode(flight);
+        const auto passengers = flight.getAllPassengers();
+        out << table.indexOf(flight.getFlightNumber()) << table.indexOf(flight.getOrigin())
+            << table.indexOf(flight.getDestination()) << flight.getDepartureTime().toMSecsSinceEpoch()
+            << flight.getBasePrice() << seatState.status << seatState.prices
+            << static_cast<quint32>(passengers.size());
+        for (const Passenger* passenger : passengers) {
+            out << table.indexOf(passenger->getFirstName()) << table.indexOf(passenger->getLastName())
+                << table.indexOf(passenger->getPhoneNumber()) << table.indexOf(passenger->getEmail())
+                << table.indexOf(passenger->getSeatNumber());
+        }
+    }
+
+    std::unique_ptr<Flight> readFlight(QDataStream& in, const QList<QString>& strings) {
+        // Out-of-range indexes from a damaged file read as empty strings
+        auto text = [&strings](quint32 index) {
+            return index < static_cast<quint32>(strings.size()) ? strings[index] : QString();
+        };
+
+        quint32 number = 0, origin = 0, destination = 0, passengerCount = 0;
+        qint64 departureMsecs = 0;
+        double basePrice = 0.0;
+        QByteArray seatStatus, seatPrices;
+        in >> number >> origin >> destination >> departureMsecs >> basePrice
+           >> seatStatus >> seatPrices >> passengerCount;
+        if (in.status() != QDataStream::Ok) {
+            return nullptr;
+        }
+
+        std::vector<std::unique_ptr<Passenger>> passengers;
+        passengers.reserve(qMin<quint32>(passengerCount, 1024));
+        for (quint32 i = 0; i < passengerCount && in.status() == QDataStream::Ok; ++i) {
+            quint32 first = 0, last = 0, phone = 0, email = 0, seat = 0;
+            in >> first >> last >> phone >> email >> seat;
+            passengers.push_back(std::make_unique<Passenger>(text(first), text(last), text(phone),
+                                                             text(email), text(seat)));
+        }
+        if (in.status() != QDataStream::Ok) {
+            return nullptr;
+        }
+
+        const QDateTime departureTime = QDateTime::fromMSecsSinceEpoch(departureMsecs);
+        std::vector<Seat::Status> statuses;
+        std::vector<double> prices;
+        if (SeatStateCodec::decode(seatStatus, seatPrices, statuses, prices)) {
+            if (auto flight = Flight::restore(text(number), text(origin), text(destination), departureTime,
+                                              basePrice, statuses, prices, std::move(passengers))) {
+                return flight;
+            }
+        }
+
+        auto flight = std::make_unique<Flight>(text(number), text(origin), text(destination),
+                                               departureTime, basePrice);
+        for (auto& passenger : passengers) {
+            flight->addPassenger(std::move(passenger));
+        }
+        return flight;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Writing
+// -----------------------------------------------------------------------------
+
+bool CompressedSnapshot::save(const QString& filename, const std::vector<std::unique_ptr<Flight>>& flights) {
+    std::vector<size_t> blockStarts;
+    for (size_t start = 0; start < flights.size(); start += kFlightsPerBlock) {
+        blockStarts.push_back(start);
+    }
+
+    StringTableBuilder table;
+    for (const auto& flight : flights) {
+        addStrings(table, *flight);
+    }
+
+    const QList<QByteArray> compressed = QtConcurrent::blockingMapped<QList<QByteArray>>(
+        blockStarts, [&flights, &table](size_t start) {
+            QByteArray records;
+            QDataStream out(&records, QIODevice::WriteOnly);
+            configure(out);
+            const size_t end = qMin(start + kFlightsPerBlock, flights.size());
+            for (size_t i = start; i < end; ++i) {
+                writeFlight(out, *flights[i], table);
+            }
+            return qCompress(records, kCompressionLevel);
+        });
+
+    QByteArray stringTable;
+    {
+        QDataStream out(&stringTable, QIODevice::WriteOnly);
+        configure(out);
+        out << table.strings();
+    }
+
+    QByteArray index;
+    {
+        QDataStream out(&index, QIODevice::WriteOnly);
+        configure(out);
+        out << qCompress(stringTable, kCompressionLevel);
+        quint64 offset = 0;
+        for (int b = 0; b < compressed.size(); ++b) {
+            const size_t count = qMin(kFlightsPerBlock, flights.size() - blockStarts[b]);
+            out << offset << static_cast<quint32>(compressed[b].size()) << static_cast<quint32>(count);
+            offset += compressed[b].size();
+        }
+        for (size_t i = 0; i < flights.size(); ++i) {
+            const Flight* flight = flights[i].get();
+            out << table.indexOf(flight->getFlightNumber()) << table.indexOf(flight->getOrigin())
+                << table.indexOf(flight->getDestination()) << flight->getDepartureTime()
+                << static_cast<quint32>(flight->getPassengerCount())
+                << static_cast<quint32>(i / kFlightsPerBlock) << static_cast<quint32>(i % kFlightsPerBlock);
+        }
+    }
+
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QDataStream header(&file);
+    configure(header);
+    header.writeRawData(kMagic, sizeof(kMagic));
+    header << kFormatVersion << quint16(0)
+           << static_cast<quint32>(index.size()) << static_cast<quint32>(compressed.size());
+    file.write(index);
+    for (const QByteArray& block : compressed) {
+        file.write(block);
+    }
+    return file.commit();
+}
+
+// -----------------------------------------------------------------------------
+// Reading
+// -----------------------------------------------------------------------------
+
+bool CompressedSnapshot::isCompressedFile(const QString& filename) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    return file.read(sizeof(kMagic)) == QByteArray(kMagic, sizeof(kMagic));
+}
+
+bool CompressedSnapshot::open(const QString& filename) {
+    path.clear();
+    strings.clear();
+    {
+        QMutexLocker locker(&cacheMutex);
+        cachedBlock = -1;
+        cachedFlights.clear();
+    }
+    blocks.clear();
+    entries.clear();
+    entryByNumber.clear();
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&file);
+    configure(in);
+
+    char magic[sizeof(kMagic)];
+    quint16 reserved = 0;
+    quint32 indexSize = 0, blockCount = 0;
+    if (in.readRawData(magic, sizeof(magic)) != sizeof(magic) ||
+        !std::equal(magic, magic + sizeof(magic), kMagic)) {
+        return false;
+    }
+    in >> version >> reserved >> indexSize >> blockCount;
+    if (in.status() != QDataStream::Ok || version < 1 || version > kFormatVersion) {
+        return false;
+    }
+
+    if (version >= kFirstStringTableVersion) {
+        QByteArray compressedStrings;
+        in >> compressedStrings;
+        QByteArray table = qUncompress(compressedStrings);
+        QDataStream tableIn(&table, QIODevice::ReadOnly);
+        configure(tableIn);
+        QStringList values;
+        tableIn >> values;
+        if (tableIn.status() != QDataStream::Ok) {
+            return false;
+        }
+        strings = values;
+    }
+    auto readString = [this, &in](QString& value) {
+        if (version < kFirstStringTableVersion) {
+            in >> value;
+            return;
+        }
+        quint32 index = 0;
+        in >> index;
+        if (index >= static_cast<quint32>(strings.size())) {
+            in.setStatus(QDataStream::ReadCorruptData);
+            return;
+        }
+        value = strings[index];
+    };
+
+    blocks.resize(blockCount);
+    quint32 flightCount = 0;
+    for (BlockEntry& block : blocks) {
+        in >> block.offset >> block.size >> block.flightCount;
+        flightCount += block.flightCount;
+    }
+    entries.resize(flightCount);
+    for (quint32 i = 0; i < flightCount; ++i) {
+        FlightEntry& entry = entries[i];
+        readString(entry.flightNumber);
+        readString(entry.origin);
+        readString(entry.destination);
+        in >> entry.departureTime;
+        if (version >= 2) {
+            in >> entry.passengerCount;
+        }
+        in >> entry.block >> entry.position;
+        if (entry.block >= blockCount) {
+            in.setStatus(QDataStream::ReadCorruptData);
+        }
+        entryByNumber.insert(entry.flightNumber, static_cast<int>(i));
+    }
+    if (in.status() != QDataStream::Ok) {
+        blocks.clear();
+        entries.clear();
+        entryByNumber.clear();
+        strings.clear();
+        return false;
+    }
+
+    blockAreaOffset = kHeaderSize + indexSize;
+    path = filename;
+    return true;
+}
+
+QByteArray CompressedSnapshot::readBlock(quint32 block) const {
+    QFile file(path);
+    if (block >= blocks.size() || !file.open(QIODevice::ReadOnly) ||
+        !file.seek(blockAreaOffset + static_cast<qint64>(blocks[block].offset))) {
+        return {};
+    }
+    return file.read(blocks[block].size);
+}
+
+std::vector<std::unique_ptr<Flight>> CompressedSnapshot::inflateBlock(const QByteArray& compressed) const {
+    std::vector<std::unique_ptr<Flight>> flights;
+    if (version >= kFirstStringTableVersion) {
+        const QByteArray records = qUncompress(compressed);
+        QDataStream in(records);
+        configure(in);
+        while (!in.atEnd()) {
+            auto flight = readFlight(in, strings);
+            if (!flight) break;
+            flights.push_back(std::move(flight));
+        }
+        return flights;
+    }
+
+    const QJsonArray array = QJsonDocument::fromJson(qUncompress(compressed)).array();
+    flights.reserve(array.size());
+    for (const QJsonValue& value : array) {
+        if (auto flight = Database::jsonToFlight(value.toObject())) {
+            flights.push_back(std::move(flight));
+        }
+    }
+    return flights;
+}
+
+bool CompressedSnapshot::loadAll(std::vector<std::unique_ptr<Flight>>& flights) const {
+    if (!isOpen()) {
+        return false;
+    }
+
+    // One sequential read of the block area, then inflate every block in parallel
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(blockAreaOffset)) {
+        return false;
+    }
+    const QByteArray area = file.readAll();
+
+    std::vector<quint32> blockIds(blocks.size());
+    std::iota(blockIds.begin(), blockIds.end(), 0u);
+    bool truncated = false;
+    for (const BlockEntry& block : blocks) {
+        if (block.offset + block.size > static_cast<quint64>(area.size())) truncated = true;
+    }
+    if (truncated) {
+        return false;
+    }
+
+    QList<std::shared_ptr<std::vector<std::unique_ptr<Flight>>>> inflated =
+        QtConcurrent::blockingMapped<QList<std::shared_ptr<std::vector<std::unique_ptr<Flight>>>>>(
+            blockIds, [this, &area](quint32 id) {
+                const BlockEntry& block = blocks[id];
+                const QByteArray compressed = QByteArray::fromRawData(area.constData() + block.offset, block.size);
+                return std::make_shared<std::vector<std::unique_ptr<Flight>>>(inflateBlock(compressed));
+            });
+
+    // A damaged block inflates short; fail rather than silently drop its flights
+    for (qsizetype i = 0; i < inflated.size(); ++i) {
+        if (inflated[i]->size() != blocks[i].flightCount) {
+            return false;
+        }
+    }
+
+    flights.clear();
+    flights.reserve(entries.size());
+    for (const auto& block : inflated) {
+        for (auto& flight : *block) {
+            flights.push_back(std::move(flight));
+        }
+    }
+    return true;
+}
+
+std::unique_ptr<Flight> CompressedSnapshot::loadFlight(const QString& flightNumber) const {
+    auto it = entryByNumber.constFind(flightNumber);
+    if (it == entryByNumber.constEnd()) {
+        return nullptr;
+    }
+    const FlightEntry& entry = entries[it.value()];
+
+    QMutexLocker locker(&cacheMutex);
+    if (cachedBlock != entry.block || entry.position >= cachedFlights.size() ||
+        !cachedFlights[entry.position]) {
+        cachedFlights = inflateBlock(readBlock(entry.block));
+        cachedBlock = entry.block;
+    }
+    if (entry.position >= cachedFlights.size()) {
+        return nullptr;
+    }
+    return std::move(cachedFlights[entry.position]);
+}
+
+std::vector<std::unique_ptr<Flight>> CompressedSnapshot::loadHeaders() const {
+    std::vector<std::unique_ptr<Flight>> headers;
+    headers.reserve(entries.size());
+    for (const FlightEntry& entry : entries) {
+        headers.push_back(Flight::createHeader(entry.flightNumber, entry.origin, entry.destination,
+                                               entry.departureTime, static_cast<int>(entry.passengerCount)));
+    }
+    return headers;
+}
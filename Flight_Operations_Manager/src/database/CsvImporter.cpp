@@ -0,0 +1,395 @@
+// This file contains the implementation for the `CsvImporter` class.
+// Parsing works on byte views into the mapped file: fields are only turned into
+// QStrings once a row has passed validation, and quoted fields are unescaped into
+// reusable scratch buffers. Seats are checked against the cabin layout in the
+// workers; seat conflicts are detected when the batch is applied to the airline.
+
+#include "database/CsvImporter.h"
+#include "models/Airline.h"
+#include "models/Flight.h"
+#include "models/Passenger.h"
+#include <QFile>
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+    constexpr qsizetype kMinChunkSize = 1024 * 1024;
+    constexpr int kMaxFields = 16;
+
+    enum Column { FlightNumberColumn, FirstNameColumn, LastNameColumn, FullNameColumn,
+                  PhoneColumn, EmailColumn, SeatColumn, ColumnCount };
+
+    struct ColumnMap {
+        int index[ColumnCount];
+        int required = 0;  // Fields a row needs to reach every mapped column
+    };
+
+    struct Chunk {
+        const char* begin;
+        const char* end;
+        qint64 firstLine;
+    };
+
+    struct Record {
+        QByteArrayView fields[kMaxFields];
+        QByteArray scratch[kMaxFields];  // Unescaped quoted fields, capacity reused
+        int count = 0;
+        bool malformed = false;
+    };
+
+    struct ParsedRow {
+        qint64 line;
+        int flight;  // Index into the flight table
+        QString firstName;
+        QString lastName;
+        QString phoneNumber;
+        QString email;
+        QString seatNumber;
+    };
+
+    struct ChunkResult {
+        std::vector<ParsedRow> rows;
+        std::vector<CsvImportError> errors;
+        qint64 rowsRead = 0;
+    };
+
+    using FlightIndex = std::unordered_map<std::string_view, int>;
+
+    // Reads one record starting at `p` and returns the position after its line
+    // break; `lines` receives the number of physical lines the record spans
+    const char* parseRecord(const char* p, const char* end, Record& record, int& lines) {
+        record.count = 0;
+        record.malformed = false;
+        lines = 1;
+
+        for (;;) {
+            const int slot = record.count < kMaxFields ? record.count : -1;
+            ++record.count;
+
+            if (p < end && *p == '"') {
+                const char* start = ++p;
+                const char* close = p;
+                bool escaped = false;
+                while (close < end) {
+                    if (*close == '"') {
+                        if (close + 1 < end && close[1] == '"') {
+                            escaped = true;
+                            close += 2;
+                            continue;
+                        }
+                        break;
+                    }
+                    if (*close == '\n') ++lines;
+                    ++close;
+                }
+                if (close >= end) {
+                    record.malformed = true;
+                    return end;
+                }
+                if (slot >= 0) {
+                    if (escaped) {
+                        QByteArray& scratch = record.scratch[slot];
+                        scratch.resize(0);
+                        for (const char* q = start; q < close; ++q) {
+                            scratch.append(*q);
+                            if (*q == '"') ++q;  // Skip the second quote of a pair
+                        }
+                        record.fields[slot] = QByteArrayView(scratch);
+                    } else {
+                        record.fields[slot] = QByteArrayView(start, close - start);
+                    }
+                }
+                p = close + 1;
+                if (p < end && *p == '\r') ++p;
+                if (p < end && *p != ',' && *p != '\n') {
+                    // Text after a closing quote: flag it and resynchronise
+                    record.malformed = true;
+                    while (p < end && *p != ',' && *p != '\n') ++p;
+                }
+            } else {
+                const char* start = p;
+                while (p < end && *p != ',' && *p != '\n') ++p;
+                if (slot >= 0) {
+                    QByteArrayView field(start, p - start);
+                    if (field.endsWith('\r') && (p >= end || *p == '\n')) field.chop(1);
+                    record.fields[slot] = field;
+                }
+            }
+
+            if (p >= end) return end;
+            if (*p == ',') {
+                ++p;
+                continue;
+            }
+            return p + 1;  // '\n'
+        }
+    }
+
+    // Splits the data into chunks that end on record boundaries, tracking quotes so
+    // that line breaks inside quoted fields never split a record. Quotes are read
+    // exactly as parseRecord() reads them: only a quote opening a field starts a
+    // quoted field, so a stray one such as O"Brien is literal text
+    std::vector<Chunk> splitChunks(const char* begin, const char* end, qint64 firstLine) {
+        const int target = qMax(1, QThreadPool::globalInstance()->maxThreadCount()) * 4;
+        const qsizetype chunkSize = qMax(kMinChunkSize, (end - begin) / target + 1);
+
+        std::vector<Chunk> chunks;
+        const char* chunkStart = begin;
+        const char* boundary = begin + qMin(chunkSize, end - begin);
+        qint64 line = firstLine;
+        qint64 chunkLine = firstLine;
+        bool inQuotes = false;
+        bool fieldStart = true;
+        for (const char* p = begin; p < end; ++p) {
+            if (inQuotes) {
+                if (*p == '"') {
+                    if (p + 1 < end && p[1] == '"') ++p;  // Escaped quote
+                    else inQuotes = false;
+                } else if (*p == '\n') {
+                    ++line;
+                }
+                continue;
+            }
+            if (*p == '"' && fieldStart) {
+                inQuotes = true;
+                fieldStart = false;
+            } else if (*p == ',') {
+                fieldStart = true;
+            } else if (*p == '\n') {
+                ++line;
+                fieldStart = true;
+                if (p + 1 >= boundary) {
+                    chunks.push_back({chunkStart, p + 1, chunkLine});
+                    chunkStart = p + 1;
+                    chunkLine = line;
+                    boundary = chunkStart + qMin(chunkSize, end - chunkStart);
+                }
+            } else {
+                fieldStart = false;
+            }
+        }
+        if (chunkStart < end) {
+            chunks.push_back({chunkStart, end, chunkLine});
+        }
+        return chunks;
+    }
+
+    int columnForName(QByteArrayView name) {
+        QByteArray key;
+        for (char c : name.trimmed()) {
+            if (c == ' ' || c == '_') continue;
+            key.append(c >= 'A' && c <= 'Z' ? static_cast<char>(c + ('a' - 'A')) : c);
+        }
+        if (key == "flightnumber" || key == "flight") return FlightNumberColumn;
+        if (key == "firstname") return FirstNameColumn;
+        if (key == "lastname") return LastNameColumn;
+        if (key == "passengername" || key == "name") return FullNameColumn;
+        if (key == "phone" || key == "phonenumber") return PhoneColumn;
+        if (key == "email") return EmailColumn;
+        if (key == "seat" || key == "seatnumber") return SeatColumn;
+        return -1;
+    }
+
+    // Returns false when the record is data rather than a header
+    bool mapHeader(const Record& record, ColumnMap& columns) {
+        std::fill(std::begin(columns.index), std::end(columns.index), -1);
+        bool isHeader = false;
+        for (int i = 0; i < qMin(record.count, kMaxFields); ++i) {
+            const int column = columnForName(record.fields[i]);
+            if (column >= 0 && columns.index[column] < 0) {
+                columns.index[column] = i;
+                isHeader = true;
+            }
+        }
+        if (!isHeader) {
+            // Layout written by Database::exportToCSV
+            std::fill(std::begin(columns.index), std::end(columns.index), -1);
+            columns.index[FlightNumberColumn] = 0;
+            columns.index[FullNameColumn] = 4;
+            columns.index[SeatColumn] = 5;
+        }
+        columns.required = 0;
+        for (int index : columns.index) {
+            columns.required = qMax(columns.required, index + 1);
+        }
+        return isHeader;
+    }
+
+    QByteArrayView field(const Record& record, const ColumnMap& columns, Column column) {
+        const int index = columns.index[column];
+        return index >= 0 ? record.fields[index].trimmed() : QByteArrayView();
+    }
+
+    ChunkResult parseChunk(const Chunk& chunk, const ColumnMap& columns,
+                           const FlightIndex& flights) {
+        ChunkResult result;
+        result.rows.reserve((chunk.end - chunk.begin) / 48);
+        Record record;
+
+        const char* p = chunk.begin;
+        qint64 line = chunk.firstLine;
+        while (p < chunk.end) {
+            int lines = 1;
+            p = parseRecord(p, chunk.end, record, lines);
+            const qint64 recordLine = line;
+            line += lines;
+            if (record.count == 1 && !record.malformed && record.fields[0].trimmed().isEmpty()) {
+                continue;  // Blank line
+            }
+            ++result.rowsRead;
+
+            auto reject = [&](const QString& message) {
+                result.errors.push_back({recordLine, message});
+            };
+            if (record.malformed) {
+                reject(QStringLiteral("Malformed quoted field"));
+                continue;
+            }
+            if (record.count < columns.required) {
+                reject(QString("Expected %1 fields, found %2").arg(columns.required).arg(record.count));
+                continue;
+            }
+
+            const QByteArrayView flightNumber = field(record, columns, FlightNumberColumn);
+            auto flight = flights.find(std::string_view(flightNumber.data(), flightNumber.size()));
+            if (flight == flights.end()) {
+                reject(QString("Unknown flight \"%1\"").arg(QString::fromUtf8(flightNumber)));
+                continue;
+            }
+
+            QByteArrayView firstName = field(record, columns, FirstNameColumn);
+            QByteArrayView lastName = field(record, columns, LastNameColumn);
+            if (columns.index[FullNameColumn] >= 0 && firstName.isEmpty() && lastName.isEmpty()) {
+                // "First Last" as exported; the first space separates the two
+                const QByteArrayView fullName = field(record, columns, FullNameColumn);
+                const qsizetype space = fullName.indexOf(' ');
+                firstName = space < 0 ? fullName : fullName.first(space);
+                lastName = space < 0 ? QByteArrayView() : fullName.sliced(space + 1).trimmed();
+            }
+            if (firstName.isEmpty() || lastName.isEmpty()) {
+                reject(QStringLiteral("Passenger first and last name are required"));
+                continue;
+            }
+
+            const QByteArrayView seatNumber = field(record, columns, SeatColumn);
+            if (!seatNumber.isEmpty() && !Flight::isLayoutSeat(seatNumber)) {
+                reject(QString("Seat \"%1\" is not in the cabin layout").arg(QString::fromUtf8(seatNumber)));
+                continue;
+            }
+
+            result.rows.push_back({recordLine, flight->second,
+                                   QString::fromUtf8(firstName),
+                                   QString::fromUtf8(lastName),
+                                   QString::fromUtf8(field(record, columns, PhoneColumn)),
+                                   QString::fromUtf8(field(record, columns, EmailColumn)),
+                                   QString::fromLatin1(seatNumber)});
+        }
+        return result;
+    }
+}
+
+CsvImportResult CsvImporter::importManifest(const QString& filename, Airline& airline) {
+    CsvImportResult result;
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        result.fatalError = file.errorString();
+        return result;
+    }
+
+    // Map the file when possible; fall back to reading it for devices that cannot be mapped
+    const qint64 size = file.size();
+    QByteArray fallback;
+    const char* data = nullptr;
+    if (size > 0) {
+        data = reinterpret_cast<const char*>(file.map(0, size));
+        if (!data) {
+            fallback = file.readAll();
+            data = fallback.constData();
+        }
+    }
+    if (!data) {
+        result.fatalError = QStringLiteral("The file is empty");
+        return result;
+    }
+    const char* begin = data;
+    const char* const end = data + size;
+    if (size >= 3 && std::equal(begin, begin + 3, "\xEF\xBB\xBF")) {
+        begin += 3;  // UTF-8 byte order mark
+    }
+
+    ColumnMap columns;
+    qint64 firstLine = 1;
+    {
+        Record header;
+        int lines = 1;
+        const char* next = parseRecord(begin, end, header, lines);
+        if (mapHeader(header, columns)) {
+            begin = next;
+            firstLine += lines;
+        }
+    }
+    if (columns.index[FlightNumberColumn] < 0 ||
+        (columns.index[FullNameColumn] < 0 &&
+         (columns.index[FirstNameColumn] < 0 || columns.index[LastNameColumn] < 0))) {
+        result.fatalError = QStringLiteral("The header must name the flight number and passenger name columns");
+        return result;
+    }
+
+    // Flight numbers as UTF-8 so workers can look them up straight from the mapped bytes
+    const auto& flights = airline.getFlights();
+    std::vector<QByteArray> flightKeys;
+    flightKeys.reserve(flights.size());
+    FlightIndex flightIndex;
+    for (const auto& flight : flights) {
+        flightKeys.push_back(flight->getFlightNumber().toUtf8());
+    }
+    for (size_t i = 0; i < flightKeys.size(); ++i) {
+        flightIndex.emplace(std::string_view(flightKeys[i].constData(), flightKeys[i].size()),
+                            static_cast<int>(i));
+    }
+
+    const std::vector<Chunk> chunks = splitChunks(begin, end, firstLine);
+    QList<ChunkResult> parsed = QtConcurrent::blockingMapped<QList<ChunkResult>>(
+        chunks, [&](const Chunk& chunk) { return parseChunk(chunk, columns, flightIndex); });
+
+    // Apply as one batch per flight, keeping file order within each flight
+    std::vector<std::vector<ParsedRow*>> rowsByFlight(flights.size());
+    for (ChunkResult& chunk : parsed) {
+        result.rowsRead += chunk.rowsRead;
+        result.errors.insert(result.errors.end(), chunk.errors.begin(), chunk.errors.end());
+        for (ParsedRow& row : chunk.rows) {
+            rowsByFlight[row.flight].push_back(&row);
+        }
+    }
+    for (size_t i = 0; i < rowsByFlight.size(); ++i) {
+        const std::vector<ParsedRow*>& rows = rowsByFlight[i];
+        if (rows.empty()) continue;
+
+        const QString flightNumber = flights[i]->getFlightNumber();
+        std::vector<std::unique_ptr<Passenger>> batch;
+        batch.reserve(rows.size());
+        for (ParsedRow* row : rows) {
+            batch.push_back(std::make_unique<Passenger>(row->firstName, row->lastName, row->phoneNumber,
+                                                        row->email, row->seatNumber));
+        }
+        const std::vector<size_t> rejected = airline.addPassengers(flightNumber, std::move(batch));
+        for (size_t index : rejected) {
+            result.errors.push_back({rows[index]->line,
+                                     QString("Seat %1 is not available on flight %2")
+                                         .arg(rows[index]->seatNumber, flightNumber)});
+        }
+        result.rowsImported += static_cast<qint64>(rows.size() - rejected.size());
+    }
+
+    std::stable_sort(result.errors.begin(), result.errors.end(),
+                     [](const CsvImportError& a, const CsvImportError& b) { return a.line < b.line; });
+    result.elapsedMs = timer.elapsed();
+    return result;
+}
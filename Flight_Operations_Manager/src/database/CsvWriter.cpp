@@ -0,0 +1,172 @@
+// This file contains the implementation for the `CsvWriter` class.
+// Fields are encoded from UTF-16 to UTF-8 in a single pass directly into the
+// output buffer; integers and timestamps are written digit by digit rather than
+// going through intermediate QString formatting.
+
+#include "database/CsvWriter.h"
+#include <cstring>
+
+namespace {
+    // Writes `value` as exactly `width` zero-padded digits
+    char* writeDigits(char* out, int value, int width) {
+        for (int i = width - 1; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+        return out + width;
+    }
+}
+
+CsvWriter::CsvWriter(qsizetype reserveBytes)
+    : used(0)
+    , atRowStart(true)
+{
+    buffer.resize(qMax<qsizetype>(reserveBytes, 256));
+}
+
+char* CsvWriter::reserve(qsizetype bytes) {
+    if (used + bytes > buffer.size()) {
+        buffer.resize(qMax(buffer.size() * 2, used + bytes));
+    }
+    return buffer.data() + used;
+}
+
+void CsvWriter::separator() {
+    if (!atRowStart) {
+        *reserve(1) = ',';
+        ++used;
+    }
+    atRowStart = false;
+}
+
+bool CsvWriter::needsQuoting(QStringView text) {
+    for (QChar c : text) {
+        const char16_t u = c.unicode();
+        if (u == ',' || u == '"' || u == '\n' || u == '\r') return true;
+    }
+    return false;
+}
+
+void CsvWriter::appendUtf8(QStringView text) {
+    // Worst case three bytes per UTF-16 unit, doubled for escaped quotes
+    char* out = reserve(text.size() * 3 + 2);
+    char* const begin = out;
+    const bool quote = needsQuoting(text);
+    if (quote) *out++ = '"';
+
+    const char16_t* p = text.utf16();
+    const char16_t* const end = p + text.size();
+    while (p < end) {
+        char32_t u = *p++;
+        if (u < 0x80) {
+            if (u == '"') *out++ = '"';
+            *out++ = static_cast<char>(u);
+        } else if (u < 0x800) {
+            *out++ = static_cast<char>(0xC0 | (u >> 6));
+            *out++ = static_cast<char>(0x80 | (u & 0x3F));
+        } else if (QChar::isHighSurrogate(u) && p < end && QChar::isLowSurrogate(*p)) {
+            u = QChar::surrogateToUcs4(static_cast<char16_t>(u), *p++);
+            *out++ = static_cast<char>(0xF0 | (u >> 18));
+            *out++ = static_cast<char>(0x80 | ((u >> 12) & 0x3F));
+            *out++ = static_cast<char>(0x80 | ((u >> 6) & 0x3F));
+            *out++ = static_cast<char>(0x80 | (u & 0x3F));
+        } else {
+            if (QChar::isSurrogate(u)) u = QChar::ReplacementCharacter;  // Unpaired surrogate
+            *out++ = static_cast<char>(0xE0 | (u >> 12));
+            *out++ = static_cast<char>(0x80 | ((u >> 6) & 0x3F));
+            *out++ = static_cast<char>(0x80 | (u & 0x3F));
+        }
+    }
+
+    if (quote) *out++ = '"';
+    used += out - begin;
+}
+
+void CsvWriter::addField(QStringView text) {
+    separator();
+    appendUtf8(text);
+}
+
+void CsvWriter::addField(QStringView first, QStringView second) {
+    separator();
+    if (!needsQuoting(first) && !needsQuoting(second)) {
+        appendUtf8(first);
+        *reserve(1) = ' ';
+        ++used;
+        appendUtf8(second);
+    } else {
+        // Rare path: quote the joined value as a whole
+        appendUtf8(QString(first) + QLatin1Char(' ') + second);
+    }
+}
+
+void CsvWriter::addField(qint64 value) {
+    separator();
+    char digits[24];
+    char* end = digits + sizeof(digits);
+    char* p = end;
+    quint64 magnitude = value < 0 ? 0 - static_cast<quint64>(value) : static_cast<quint64>(value);
+    do {
+        *--p = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude);
+    if (value < 0) *--p = '-';
+
+    const qsizetype length = end - p;
+    std::memcpy(reserve(length), p, length);
+    used += length;
+}
+
+void CsvWriter::addField(const QDateTime& value) {
+    separator();
+    if (!value.isValid()) return;
+
+    const QDate date = value.date();
+    if (date.year() < 0 || date.year() > 9999) {
+        // Out of range for the fixed-width digits; rare enough to format normally
+        appendUtf8(value.toString("yyyy-MM-dd hh:mm"));
+        return;
+    }
+    const QTime time = value.time();
+    char* out = reserve(16);
+    char* const begin = out;
+    out = writeDigits(out, date.year(), 4);
+    *out++ = '-';
+    out = writeDigits(out, date.month(), 2);
+    *out++ = '-';
+    out = writeDigits(out, date.day(), 2);
+    *out++ = ' ';
+    out = writeDigits(out, time.hour(), 2);
+    *out++ = ':';
+    out = writeDigits(out, time.minute(), 2);
+    used += out - begin;
+}
+
+void CsvWriter::addRawField(const QByteArray& encoded) {
+    separator();
+    std::memcpy(reserve(encoded.size()), encoded.constData(), encoded.size());
+    used += encoded.size();
+}
+
+void CsvWriter::endRow() {
+    // RFC 4180 record separator
+    char* out = reserve(2);
+    out[0] = '\r';
+    out[1] = '\n';
+    used += 2;
+    atRowStart = true;
+}
+
+QByteArray CsvWriter::encodeField(QStringView text) {
+    CsvWriter writer(text.size() * 3 + 2);
+    writer.appendUtf8(text);
+    return writer.takeData();
+}
+
+QByteArray CsvWriter::takeData() {
+    buffer.truncate(used);
+    QByteArray data = std::move(buffer);
+    buffer = QByteArray();
+    clear();
+    return data;
+}
@@ -4,9 +4,24 @@
 // to perform save, load, update, and delete operations for various data models.
 
 #include "database/Database.h"
+#include "database/CsvWriter.h"
+#include "database/SeatStateCodec.h"
 #include <QFile>
-#include <QTextStream>
+#include <QSaveFile>
+#include <QFileInfo>
 #include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+
+namespace {
+    // Guards appends to and rotation of a journal file
+    QMutex journalMutex;
+    // Held for the whole of a compaction so a full save cannot interleave with it
+    QMutex compactionMutex;
+}
 
 bool Database::saveData(const QString& filename, const std::vector<std::unique_ptr<Flight>>& flights) {
     QJsonArray flightsArray;
@@ -18,16 +33,29 @@ bool Database::saveData(const QString& filename, const std::vector<std::unique_p
     root["flights"] = flightsArray;
     
     QJsonDocument doc(root);
-    QFile file(filename);
+    QMutexLocker compactionLocker(&compactionMutex);
+    // Written to a temporary and renamed so a crash never leaves a torn snapshot
+    QSaveFile file(filename);
     if (!file.open(QIODevice::WriteOnly)) {
         return false;
     }
     
     file.write(doc.toJson());
+    if (!file.commit()) {
+        return false;
+    }
+
+    // A full snapshot supersedes any pending deltas
+    QMutexLocker journalLocker(&journalMutex);
+    QFile::remove(compactingPath(filename));
+    QFile::remove(journalPath(filename));
     return true;
 }
 
 bool Database::loadData(const QString& filename, std::vector<std::unique_ptr<Flight>>& flights) {
+    // A compaction committing between the base read and the journal reads would
+    // drop the deltas it folded, so the base and journals are read as one unit
+    QMutexLocker compactionLocker(&compactionMutex);
     QFile file(filename);
     if (!file.open(QIODevice::ReadOnly)) {
         return false;
@@ -41,6 +69,14 @@ bool Database::loadData(const QString& filename, std::vector<std::unique_ptr<Fli
     
     QJsonObject root = doc.object();
     QJsonArray flightsArray = root["flights"].toArray();
+
+    {
+        // Fold deltas saved since the base snapshot, oldest journal first
+        QMutexLocker journalLocker(&journalMutex);
+        applyJournal(compactingPath(filename), flightsArray);
+        applyJournal(journalPath(filename), flightsArray);
+    }
+    compactionLocker.unlock();
     
     flights.clear();
     for (const QJsonValue& value : flightsArray) {
@@ -54,36 +90,205 @@ bool Database::loadData(const QString& filename, std::vector<std::unique_ptr<Fli
 
 bool Database::exportToCSV(const QString& filename, const std::vector<std::unique_ptr<Flight>>& flights) {
     QFile file(filename);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    if (!file.open(QIODevice::WriteOnly)) {
         return false;
     }
-    
-    QTextStream out(&file);
-    
-    // Write header
-    out << "Flight Number,Origin,Destination,Departure Time,Passenger Name,Seat Number\n";
-    
-    // Write data
-    for (const auto& flight : flights) {
-        QString flightNumber = flight->getFlightNumber();
-        QString origin = flight->getOrigin();
-        QString destination = flight->getDestination();
-        QString departureTime = flight->getDepartureTime().toString("yyyy-MM-dd hh:mm");
-        
-        for (const auto& passenger : flight->getAllPassengers()) {
-            out << QString("%1,%2,%3,%4,%5,%6\n")
-                   .arg(flightNumber)
-                   .arg(origin)
-                   .arg(destination)
-                   .arg(departureTime)
-                   .arg(passenger->getFullName())
-                   .arg(passenger->getSeatNumber());
+
+    CsvWriter header(128);
+    for (const char* column : {"Flight Number", "Origin", "Destination", "Departure Time",
+                               "Passenger Name", "Seat Number"}) {
+        header.addField(QString::fromLatin1(column));
+    }
+    header.endRow();
+    if (file.write(header.constData(), header.size()) != header.size()) {
+        return false;
+    }
+
+    // Each flight is formatted into its own buffer on the thread pool; a bounded
+    // window keeps memory flat while the chunks are written back in flight order
+    const int window = qMax(1, QThreadPool::globalInstance()->maxThreadCount()) * 4;
+    std::vector<const Flight*> batch;
+    batch.reserve(window);
+    for (size_t start = 0; start < flights.size(); start += window) {
+        batch.clear();
+        for (size_t i = start; i < flights.size() && i < start + window; ++i) {
+            batch.push_back(flights[i].get());
+        }
+        const QList<QByteArray> chunks = QtConcurrent::blockingMapped<QList<QByteArray>>(batch, &flightToCsv);
+        for (const QByteArray& chunk : chunks) {
+            if (file.write(chunk) != chunk.size()) {
+                return false;
+            }
         }
     }
-    
     return true;
 }
 
+QByteArray Database::flightToCsv(const Flight* flight) {
+    // Flight columns are identical on every row, so encode them once
+    const QByteArray flightNumber = CsvWriter::encodeField(flight->getFlightNumber());
+    const QByteArray origin = CsvWriter::encodeField(flight->getOrigin());
+    const QByteArray destination = CsvWriter::encodeField(flight->getDestination());
+    CsvWriter scratch(32);
+    scratch.addField(flight->getDepartureTime());
+    const QByteArray departureTime = scratch.takeData();
+
+    const auto passengers = flight->getAllPassengers();
+    const qsizetype rowEstimate = flightNumber.size() + origin.size() + destination.size()
+                                + departureTime.size() + 48;
+    CsvWriter writer(rowEstimate * qMax<qsizetype>(1, passengers.size()));
+    for (const Passenger* passenger : passengers) {
+        writer.addRawField(flightNumber);
+        writer.addRawField(origin);
+        writer.addRawField(destination);
+        writer.addRawField(departureTime);
+        writer.addField(passenger->getFirstName(), passenger->getLastName());
+        writer.addField(passenger->getSeatNumber());
+        writer.endRow();
+    }
+    return writer.takeData();
+}
+
+QString Database::journalPath(const QString& filename) {
+    return filename + ".journal";
+}
+
+QString Database::compactingPath(const QString& filename) {
+    return filename + ".journal.compacting";
+}
+
+qint64 Database::journalSize(const QString& filename) {
+    QMutexLocker locker(&journalMutex);
+    return QFileInfo(journalPath(filename)).size();
+}
+
+bool Database::saveDelta(const QString& filename, const std::vector<Flight*>& changedFlights,
+                         const QStringList& removedFlights) {
+    // One compact JSON record per line so a torn tail only loses the last record
+    QByteArray records;
+    for (const QString& flightNumber : removedFlights) {
+        QJsonObject record;
+        record["op"] = "remove";
+        record["flightNumber"] = flightNumber;
+        records += QJsonDocument(record).toJson(QJsonDocument::Compact);
+        records += '\n';
+    }
+    for (const Flight* flight : changedFlights) {
+        QJsonObject record;
+        record["op"] = "put";
+        record["flight"] = flightToJson(flight);
+        records += QJsonDocument(record).toJson(QJsonDocument::Compact);
+        records += '\n';
+    }
+    if (records.isEmpty()) {
+        return true;
+    }
+
+    QMutexLocker locker(&journalMutex);
+    QFile file(journalPath(filename));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        return false;
+    }
+    return file.write(records) == records.size() && file.flush();
+}
+
+bool Database::compactJournal(const QString& filename) {
+    QMutexLocker compactionLocker(&compactionMutex);
+
+    {
+        // Freeze the live journal; deltas saved meanwhile start a fresh one.
+        // A leftover compacting file from an interrupted run is folded first.
+        QMutexLocker journalLocker(&journalMutex);
+        if (!QFile::exists(compactingPath(filename))) {
+            if (!QFile::exists(journalPath(filename))) {
+                return true;
+            }
+            if (!QFile::rename(journalPath(filename), compactingPath(filename))) {
+                return false;
+            }
+        }
+    }
+
+    QFile base(filename);
+    if (!base.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QJsonDocument doc = QJsonDocument::fromJson(base.readAll());
+    base.close();
+    if (doc.isNull()) {
+        return false;
+    }
+
+    QJsonObject root = doc.object();
+    QJsonArray flightsArray = root["flights"].toArray();
+    applyJournal(compactingPath(filename), flightsArray);
+    root["flights"] = flightsArray;
+
+    // Replace the base atomically; readers see either the old or the new snapshot
+    QSaveFile out(filename);
+    if (!out.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    out.write(QJsonDocument(root).toJson());
+    if (!out.commit()) {
+        return false;
+    }
+
+    QMutexLocker journalLocker(&journalMutex);
+    return QFile::remove(compactingPath(filename));
+}
+
+void Database::applyJournal(const QString& path, QJsonArray& flightsArray) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QHash<QString, qsizetype> index;
+    for (qsizetype i = 0; i < flightsArray.size(); ++i) {
+        index.insert(flightsArray.at(i).toObject().value("flightNumber").toString(), i);
+    }
+
+    bool removedAny = false;
+    while (!file.atEnd()) {
+        QJsonParseError error;
+        QJsonDocument record = QJsonDocument::fromJson(file.readLine(), &error);
+        if (error.error != QJsonParseError::NoError) {
+            continue;  // Torn record from an interrupted append
+        }
+
+        QJsonObject obj = record.object();
+        QString op = obj.value("op").toString();
+        if (op == "put") {
+            QJsonObject flight = obj.value("flight").toObject();
+            QString flightNumber = flight.value("flightNumber").toString();
+            auto it = index.find(flightNumber);
+            if (it != index.end()) {
+                flightsArray.replace(*it, flight);
+            } else {
+                index.insert(flightNumber, flightsArray.size());
+                flightsArray.append(flight);
+            }
+        } else if (op == "remove") {
+            auto it = index.find(obj.value("flightNumber").toString());
+            if (it != index.end()) {
+                flightsArray.replace(*it, QJsonValue());
+                index.erase(it);
+                removedAny = true;
+            }
+        }
+    }
+
+    if (removedAny) {
+        QJsonArray remaining;
+        for (const QJsonValue& value : flightsArray) {
+            if (!value.isNull())
+                remaining.append(value);
+        }
+        flightsArray = remaining;
+    }
+}
+
 QJsonObject Database::flightToJson(const Flight* flight) {
     QJsonObject obj;
     obj["flightNumber"] = flight->getFlightNumber();
@@ -92,6 +297,14 @@ QJsonObject Database::flightToJson(const Flight* flight) {
     obj["departureTime"] = flight->getDepartureTime().toString(Qt::ISODate);
     obj["rows"] = flight->getRows();
     obj["cols"] = flight->getCols();
+    obj["basePrice"] = flight->getBasePrice();
+
+    // Prices, reservations and blocks; see SeatStateCodec for the encoding
+    const SeatStateCodec::Encoded seatState = SeatStateCodec::encode(*flight);
+    if (!seatState.isEmpty()) {
+        obj["seatStatus"] = QString::fromLatin1(seatState.status.toBase64());
+        obj["seatPrices"] = QString::fromLatin1(seatState.prices.toBase64());
+    }
     
     QJsonArray passengersArray;
     for (const auto& passenger : flight->getAllPassengers()) {
@@ -107,6 +320,7 @@ QJsonObject Database::passengerToJson(const Passenger* passenger) {
     obj["firstName"] = passenger->getFirstName();
     obj["lastName"] = passenger->getLastName();
     obj["phoneNumber"] = passenger->getPhoneNumber();
+    obj["email"] = passenger->getEmail();
     obj["seatNumber"] = passenger->getSeatNumber();
     return obj;
 }
@@ -116,10 +330,29 @@ std::unique_ptr<Flight> Database::jsonToFlight(const QJsonObject& json) {
     QString origin = json["origin"].toString();
     QString destination = json["destination"].toString();
     QDateTime departureTime = QDateTime::fromString(json["departureTime"].toString(), Qt::ISODate);
+    double basePrice = json["basePrice"].toDouble(500.0);
+    QJsonArray passengersArray = json["passengers"].toArray();
+
+    // Files with saved seat state restore it as-is instead of re-pricing the cabin
+    std::vector<Seat::Status> statuses;
+    std::vector<double> prices;
+    if (json.contains("seatStatus") &&
+        SeatStateCodec::decode(QByteArray::fromBase64(json["seatStatus"].toString().toLatin1()),
+                               QByteArray::fromBase64(json["seatPrices"].toString().toLatin1()),
+                               statuses, prices)) {
+        std::vector<std::unique_ptr<Passenger>> passengers;
+        passengers.reserve(passengersArray.size());
+        for (const QJsonValue& value : passengersArray) {
+            passengers.push_back(jsonToPassenger(value.toObject()));
+        }
+        if (auto flight = Flight::restore(flightNumber, origin, destination, departureTime, basePrice,
+                                          statuses, prices, std::move(passengers))) {
+            return flight;
+        }
+    }
     
-    auto flight = std::make_unique<Flight>(flightNumber, origin, destination, departureTime);
+    auto flight = std::make_unique<Flight>(flightNumber, origin, destination, departureTime, basePrice);
     
-    QJsonArray passengersArray = json["passengers"].toArray();
     for (const QJsonValue& value : passengersArray) {
         if (auto passenger = jsonToPassenger(value.toObject())) {
             flight->addPassenger(std::move(passenger));
@@ -133,7 +366,8 @@ std::unique_ptr<Passenger> Database::jsonToPassenger(const QJsonObject& json) {
     QString firstName = json["firstName"].toString();
     QString lastName = json["lastName"].toString();
     QString phoneNumber = json["phoneNumber"].toString();
+    QString email = json["email"].toString();
     QString seatNumber = json["seatNumber"].toString();
     
-    return std::make_unique<Passenger>(firstName, lastName, phoneNumber, seatNumber);
+    return std::make_unique<Passenger>(firstName, lastName, phoneNumber, email, seatNumber);
 } 
\ No newline at end of file
@@ -0,0 +1,350 @@
+// This file contains the implementation for the `OperationLog` class.
+// It frames booking operations as checksummed records, appends them to the
+// write-ahead log, forces them to disk according to the sync policy, and replays
+// intact records into an `Airline` during crash recovery.
+
+#include "database/OperationLog.h"
+#include "models/Airline.h"
+#include "models/Flight.h"
+#include "models/Passenger.h"
+#include <QTimer>
+#include <QDateTime>
+#include <QDebug>
+#include <QtEndian>
+#include <array>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    // Frame header: payload length followed by the CRC-32 of the payload
+    constexpr qint64 kHeaderSize = 8;
+    // Anything larger is treated as a corrupt length field
+    constexpr quint32 kMaxPayloadSize = 16 * 1024 * 1024;
+    // Passengers per AddPassengers record, keeping large imports well under the limit
+    constexpr int kPassengersPerRecord = 4096;
+
+    std::array<quint32, 256> makeCrcTable() {
+        std::array<quint32, 256> table{};
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        return table;
+    }
+
+    quint32 crc32(const char* data, qsizetype size) {
+        static const std::array<quint32, 256> table = makeCrcTable();
+        quint32 crc = 0xFFFFFFFFu;
+        for (qsizetype i = 0; i < size; ++i)
+            crc = table[(crc ^ static_cast<quint8>(data[i])) & 0xFF] ^ (crc >> 8);
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    bool syncToDisk(QFile& file) {
+        if (!file.flush()) return false;
+#ifdef Q_OS_WIN
+        return _commit(file.handle()) == 0;
+#else
+        return ::fsync(file.handle()) == 0;
+#endif
+    }
+}
+
+OperationLog::OperationLog(QObject* parent)
+    : QObject(parent)
+    , policy(SyncPolicy::Batched)
+    , batchSize(64)
+    , unsyncedCount(0)
+    , syncTimer(new QTimer(this))
+{
+    connect(syncTimer, &QTimer::timeout, this, &OperationLog::sync);
+}
+
+OperationLog::~OperationLog() {
+    blockSignals(true);  // Observers may already be half destroyed
+    close();
+}
+
+bool OperationLog::open(const QString& path) {
+    close();
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+
+    // Cut off a torn tail left by a crash so new records follow intact ones
+    qint64 valid = validLength(file.readAll());
+    if (valid != file.size() && !file.resize(valid)) {
+        file.close();
+        return false;
+    }
+    file.seek(valid);
+    unsyncedCount = 0;
+    return true;
+}
+
+void OperationLog::close() {
+    if (file.isOpen()) {
+        sync();
+        file.close();
+    }
+}
+
+bool OperationLog::reset() {
+    if (!file.isOpen()) return false;
+    if (!file.resize(0)) return false;
+    file.seek(0);
+    unsyncedCount = 0;
+    return syncToDisk(file);
+}
+
+bool OperationLog::rotate(const QString& archivePath) {
+    if (!file.isOpen()) return false;
+    if (!file.seek(0)) return false;
+    const QByteArray records = file.read(file.size());
+
+    // Appended rather than replaced: an archive left by a failed snapshot still
+    // precedes these records
+    QFile archive(archivePath);
+    if (!archive.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        file.seek(file.size());
+        return false;
+    }
+    const qint64 archiveSize = archive.size();
+    if (archive.write(records) != records.size() || !syncToDisk(archive)) {
+        archive.resize(archiveSize);  // Never leave a torn frame ahead of later appends
+        file.seek(file.size());
+        return false;
+    }
+    archive.close();
+    return reset();
+}
+
+bool OperationLog::sync() {
+    if (!file.isOpen() || unsyncedCount == 0) return true;
+    unsyncedCount = 0;
+    if (syncToDisk(file)) return true;
+    fail("sync");
+    return false;
+}
+
+void OperationLog::setSyncPolicy(SyncPolicy newPolicy, int newBatchSize, int intervalMs) {
+    sync();
+    policy = newPolicy;
+    batchSize = qMax(1, newBatchSize);
+    if (policy == SyncPolicy::Timed) {
+        syncTimer->start(qMax(1, intervalMs));
+    } else {
+        syncTimer->stop();
+    }
+}
+
+void OperationLog::append(const QByteArray& payload) {
+    QByteArray frames;
+    frame(frames, payload);
+    appendFrames(frames);
+}
+
+void OperationLog::frame(QByteArray& out, const QByteArray& payload) {
+    char header[kHeaderSize];
+    qToLittleEndian<quint32>(static_cast<quint32>(payload.size()), header);
+    qToLittleEndian<quint32>(crc32(payload.constData(), payload.size()), header + 4);
+    out.reserve(out.size() + kHeaderSize + payload.size());
+    out.append(header, kHeaderSize);
+    out.append(payload);
+}
+
+void OperationLog::appendFrames(const QByteArray& frames) {
+    if (!file.isOpen()) return;
+
+    // One write per append: the bytes reach the OS even if the process dies next
+    const qint64 start = file.pos();
+    if (file.write(frames) != frames.size() || !file.flush()) {
+        file.resize(start);  // Best effort; replay stops at a torn frame anyway
+        fail("write");
+        return;
+    }
+
+    ++unsyncedCount;
+    if (policy == SyncPolicy::PerOperation ||
+        (policy == SyncPolicy::Batched && unsyncedCount >= batchSize)) {
+        sync();
+    }
+}
+
+void OperationLog::fail(const char* operation) {
+    // Appending after a lost record would replay later operations without it
+    const QString path = file.fileName();
+    qWarning() << "Operation log" << operation << "failed on" << path << ":" << file.errorString()
+               << "- no further operations are recorded";
+    file.close();
+    unsyncedCount = 0;
+    emit writeFailed(path);
+}
+
+qint64 OperationLog::validLength(const QByteArray& data, QList<QByteArray>* payloads) {
+    qint64 pos = 0;
+    while (data.size() - pos >= kHeaderSize) {
+        const char* header = data.constData() + pos;
+        quint32 length = qFromLittleEndian<quint32>(header);
+        quint32 checksum = qFromLittleEndian<quint32>(header + 4);
+        if (length > kMaxPayloadSize || data.size() - pos - kHeaderSize < length) break;
+
+        const char* payload = header + kHeaderSize;
+        if (crc32(payload, length) != checksum) break;
+        if (payloads) payloads->append(QByteArray(payload, length));
+        pos += kHeaderSize + length;
+    }
+    return pos;
+}
+
+// -----------------------------------------------------------------------------
+// Recording
+// -----------------------------------------------------------------------------
+
+void OperationLog::logAddFlight(const Flight& flight) {
+    record(Op::AddFlight, flight.getFlightNumber(), flight.getOrigin(), flight.getDestination(),
+           flight.getDepartureTime(), flight.getBasePrice());
+}
+
+void OperationLog::logRemoveFlight(const QString& flightNumber) {
+    record(Op::RemoveFlight, flightNumber);
+}
+
+void OperationLog::logUpdateFlight(const QString& oldFlightNumber, const Flight& flight) {
+    record(Op::UpdateFlight, oldFlightNumber, flight.getFlightNumber(), flight.getOrigin(),
+           flight.getDestination(), flight.getDepartureTime(), flight.getBasePrice());
+}
+
+void OperationLog::logAddPassenger(const QString& flightNumber, const Passenger& passenger) {
+    record(Op::AddPassenger, flightNumber, passenger.getFirstName(), passenger.getLastName(),
+           passenger.getPhoneNumber(), passenger.getEmail(), passenger.getSeatNumber());
+}
+
+void OperationLog::logAddPassengers(const QString& flightNumber,
+                                    const std::vector<const Passenger*>& passengers) {
+    if (!file.isOpen() || passengers.empty()) return;
+
+    QByteArray frames;
+    for (size_t first = 0; first < passengers.size(); first += kPassengersPerRecord) {
+        const size_t last = qMin(passengers.size(), first + kPassengersPerRecord);
+        QByteArray payload;
+        QDataStream out(&payload, QIODevice::WriteOnly);
+        out << static_cast<quint8>(Op::AddPassengers) << flightNumber << static_cast<quint32>(last - first);
+        for (size_t i = first; i < last; ++i) {
+            const Passenger& p = *passengers[i];
+            out << p.getFirstName() << p.getLastName() << p.getPhoneNumber() << p.getEmail() << p.getSeatNumber();
+        }
+        frame(frames, payload);
+    }
+    appendFrames(frames);
+}
+
+void OperationLog::logRemovePassenger(const QString& flightNumber, const QString& passengerId) {
+    record(Op::RemovePassenger, flightNumber, passengerId);
+}
+
+void OperationLog::logBookSeat(const QString& flightNumber, const QString& passengerId, const QString& seatNumber) {
+    record(Op::BookSeat, flightNumber, passengerId, seatNumber);
+}
+
+void OperationLog::logCancelBooking(const QString& flightNumber, const QString& passengerId) {
+    record(Op::CancelBooking, flightNumber, passengerId);
+}
+
+void OperationLog::logChangeBooking(const QString& flightNumber, const QString& passengerId, const QString& newSeatNumber) {
+    record(Op::ChangeBooking, flightNumber, passengerId, newSeatNumber);
+}
+
+// -----------------------------------------------------------------------------
+// Recovery
+// -----------------------------------------------------------------------------
+
+int OperationLog::replay(const QString& path, Airline& airline) {
+    QFile in(path);
+    if (!in.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+
+    QList<QByteArray> payloads;
+    validLength(in.readAll(), &payloads);
+
+    int applied = 0;
+    for (const QByteArray& payload : payloads) {
+        if (applyRecord(payload, airline))
+            ++applied;
+    }
+    return applied;
+}
+
+bool OperationLog::applyRecord(const QByteArray& payload, Airline& airline) {
+    QDataStream in(payload);
+    quint8 rawOp = 0;
+    in >> rawOp;
+
+    QString flightNumber, origin, destination, passengerId, seatNumber;
+    QDateTime departureTime;
+    double basePrice = 0.0;
+
+    switch (static_cast<Op>(rawOp)) {
+        case Op::AddFlight:
+            in >> flightNumber >> origin >> destination >> departureTime >> basePrice;
+            return airline.addFlight(std::make_unique<Flight>(flightNumber, origin, destination,
+                                                              departureTime, basePrice));
+        case Op::RemoveFlight:
+            in >> flightNumber;
+            if (!airline.getFlight(flightNumber)) return false;
+            airline.removeFlight(flightNumber);
+            return true;
+        case Op::UpdateFlight: {
+            QString oldFlightNumber;
+            in >> oldFlightNumber >> flightNumber >> origin >> destination >> departureTime >> basePrice;
+            Flight* oldFlight = airline.getFlight(oldFlightNumber);
+            if (!oldFlight) return false;
+            auto newFlight = std::make_unique<Flight>(flightNumber, origin, destination,
+                                                      departureTime, basePrice);
+            // Passengers carry over, as they do when a flight is edited in the UI
+            for (auto* p : oldFlight->getAllPassengers())
+                newFlight->addPassenger(std::make_unique<Passenger>(*p));
+            return airline.updateFlight(oldFlightNumber, std::move(newFlight));
+        }
+        case Op::AddPassenger: {
+            QString firstName, lastName, phoneNumber, email;
+            in >> flightNumber >> firstName >> lastName >> phoneNumber >> email >> seatNumber;
+            return airline.addPassenger(std::make_unique<Passenger>(firstName, lastName, phoneNumber,
+                                                                    email, seatNumber), flightNumber);
+        }
+        case Op::AddPassengers: {
+            quint32 count = 0;
+            in >> flightNumber >> count;
+            std::vector<std::unique_ptr<Passenger>> passengers;
+            for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+                QString firstName, lastName, phoneNumber, email;
+                in >> firstName >> lastName >> phoneNumber >> email >> seatNumber;
+                passengers.push_back(std::make_unique<Passenger>(firstName, lastName, phoneNumber,
+                                                                 email, seatNumber));
+            }
+            const size_t total = passengers.size();
+            return airline.addPassengers(flightNumber, std::move(passengers)).size() < total;
+        }
+        case Op::RemovePassenger:
+            in >> flightNumber >> passengerId;
+            return airline.removePassenger(passengerId, flightNumber);
+        case Op::BookSeat:
+            in >> flightNumber >> passengerId >> seatNumber;
+            return airline.bookSeat(flightNumber, passengerId, seatNumber);
+        case Op::CancelBooking:
+            in >> flightNumber >> passengerId;
+            return airline.cancelBooking(flightNumber, passengerId);
+        case Op::ChangeBooking:
+            in >> flightNumber >> passengerId >> seatNumber;
+            return airline.changeBooking(flightNumber, passengerId, seatNumber);
+    }
+    return false;
+}
@@ -0,0 +1,145 @@
+// This file contains the implementation for the `SQLiteConnectionManager` class.
+// It opens the single writer connection on a dedicated thread, runs write work there,
+// and lazily creates a tuned read-only connection for each thread that queries.
+
+#include "database/SQLiteConnectionManager.h"
+#include <QSqlQuery>
+#include <QThread>
+#include <QDebug>
+#include <QtConcurrent/QtConcurrentRun>
+#include <iterator>
+#include <utility>
+
+namespace {
+    const char* const kWriterPragmas[] = {
+        "PRAGMA journal_mode = WAL",
+        "PRAGMA synchronous = NORMAL",
+        "PRAGMA foreign_keys = ON",
+        "PRAGMA temp_store = MEMORY",
+        "PRAGMA cache_size = -65536",      // 64 MiB page cache
+        "PRAGMA mmap_size = 268435456",    // 256 MiB memory-mapped reads
+        "PRAGMA busy_timeout = 5000",
+    };
+
+    // Readers see the last committed snapshot and never block the writer in WAL mode
+    const char* const kReaderPragmas[] = {
+        "PRAGMA query_only = ON",
+        "PRAGMA temp_store = MEMORY",
+        "PRAGMA cache_size = -16384",      // 16 MiB page cache per reader
+        "PRAGMA mmap_size = 268435456",
+        "PRAGMA busy_timeout = 5000",
+    };
+
+    void applyPragmas(QSqlDatabase& db, const char* const* pragmas, size_t count) {
+        QSqlQuery query(db);
+        for (size_t i = 0; i < count; ++i)
+            query.exec(QString::fromLatin1(pragmas[i]));
+    }
+}
+
+SQLiteConnectionManager::ReaderConnection::~ReaderConnection() {
+    // close() may already have removed this connection from another thread
+    if (!QSqlDatabase::contains(name)) return;
+    {
+        QSqlDatabase db = QSqlDatabase::database(name, false);
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(name);
+}
+
+SQLiteConnectionManager::SQLiteConnectionManager(const QString& databasePath)
+    : databasePath(databasePath)
+    , writerName("fom_writer")
+{
+    // Keep the one writer thread alive so the writer connection never changes threads
+    writerThread.setMaxThreadCount(1);
+    writerThread.setExpiryTimeout(-1);
+}
+
+SQLiteConnectionManager::~SQLiteConnectionManager() {
+    // Owned by a function-local static, so this can run after QCoreApplication is gone,
+    // when Qt SQL can no longer be used safely. Closing is the owner's job.
+    if (opened.load())
+        qWarning() << "SQLiteConnectionManager destroyed without close();" << databasePath
+                   << "connections were leaked";
+    writerThread.waitForDone();
+}
+
+bool SQLiteConnectionManager::open() {
+    if (opened.load()) return true;
+
+    bool ok = QtConcurrent::run(&writerThread, [this] {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", writerName);
+        db.setDatabaseName(databasePath);
+        if (!db.open()) {
+            qWarning() << "Failed to open writer connection to" << databasePath;
+            return false;
+        }
+        applyPragmas(db, kWriterPragmas, std::size(kWriterPragmas));
+        return true;
+    }).result();
+
+    opened.store(ok);
+    return ok;
+}
+
+void SQLiteConnectionManager::close() {
+    if (!opened.exchange(false)) return;
+
+    QtConcurrent::run(&writerThread, [this] {
+        {
+            QSqlDatabase db = QSqlDatabase::database(writerName, false);
+            db.close();
+        }
+        QSqlDatabase::removeDatabase(writerName);
+    }).waitForFinished();
+
+    // Retire every reader: the calling thread's now, the rest by name. A thread that
+    // still holds its stale entry sees the new generation on its next use.
+    ++generation;
+    readers.setLocalData(nullptr);
+
+    QMutexLocker lock(&readersMutex);
+    for (const QString& name : std::as_const(readerNames))
+        QSqlDatabase::removeDatabase(name);
+    readerNames.clear();
+}
+
+bool SQLiteConnectionManager::write(const std::function<bool(QSqlDatabase&)>& work) {
+    if (!opened.load()) return false;
+
+    return QtConcurrent::run(&writerThread, [this, &work] {
+        QSqlDatabase db = QSqlDatabase::database(writerName, false);
+        return db.isOpen() && work(db);
+    }).result();
+}
+
+QSqlDatabase SQLiteConnectionManager::reader() {
+    ReaderConnection* connection = readers.hasLocalData() ? readers.localData() : nullptr;
+    if (connection && connection->generation != generation.load()) {
+        readers.setLocalData(nullptr);  // Deletes and removes the stale connection
+        connection = nullptr;
+    }
+
+    if (!connection) {
+        connection = new ReaderConnection;
+        connection->name = QString("fom_reader_%1_%2")
+                               .arg(reinterpret_cast<quintptr>(QThread::currentThreadId()))
+                               .arg(++readerSerial);
+        connection->generation = generation.load();
+
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connection->name);
+        db.setDatabaseName(databasePath);
+        if (db.open()) {
+            applyPragmas(db, kReaderPragmas, std::size(kReaderPragmas));
+        } else {
+            qWarning() << "Failed to open reader connection to" << databasePath;
+        }
+        {
+            QMutexLocker lock(&readersMutex);
+            readerNames.insert(connection->name);
+        }
+        readers.setLocalData(connection);
+    }
+    return QSqlDatabase::database(connection->name, false);
+}
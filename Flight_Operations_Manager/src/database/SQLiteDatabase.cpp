@@ -1,20 +1,63 @@
 // This file contains the implementation for the `SQLiteDatabase` class.
 // It provides methods for interacting with an SQLite database to store and retrieve
-// flight and passenger data for the Flight Operations Manager application.
+// flight, seat and passenger rows for the Flight Operations Manager application,
+// and answers searches and occupancy counts directly in SQL.
 
 #include "database/SQLiteDatabase.h"
+#include "models/Airline.h"
+#include "models/Flight.h"
+#include "models/Passenger.h"
 #include <QDebug>
 #include <QDir>
+#include <QHash>
+#include <QSet>
+#include <QSqlError>
+#include <QVariant>
 
-SQLiteDatabase::SQLiteDatabase() : connected(false) {
-    db = QSqlDatabase::addDatabase("QSQLITE");
-    db.setDatabaseName(QDir::currentPath() + "/flightmanagement.db");
+namespace {
+    constexpr int kSchemaVersion = 1;
+
+    // Statements prepared once per connection and reused through statement()
+    const char* const kUpsertFlightSql =
+        "INSERT INTO flights (flight_number, origin, destination, departure_time, base_price, seat_rows, seat_cols) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?) "
+        "ON CONFLICT(flight_number) DO UPDATE SET origin = excluded.origin, "
+        "destination = excluded.destination, departure_time = excluded.departure_time, "
+        "base_price = excluded.base_price, seat_rows = excluded.seat_rows, seat_cols = excluded.seat_cols";
+    const char* const kUpsertSeatSql =
+        "INSERT INTO seats (flight_number, seat_number, seat_class, price, status) "
+        "VALUES (?, ?, ?, ?, ?) "
+        "ON CONFLICT(flight_number, seat_number) DO UPDATE SET "
+        "seat_class = excluded.seat_class, price = excluded.price, status = excluded.status";
+    // Seated passengers are keyed by the partial unique index on (flight, seat), so
+    // re-saving one updates it in place; seatless passengers are always inserted
+    const char* const kUpsertPassengerSql =
+        "INSERT INTO passengers (flight_number, first_name, last_name, phone, email, seat_number) "
+        "VALUES (?, ?, ?, ?, ?, ?) "
+        "ON CONFLICT(flight_number, seat_number) WHERE seat_number IS NOT NULL DO UPDATE SET "
+        "first_name = excluded.first_name, last_name = excluded.last_name, "
+        "phone = excluded.phone, email = excluded.email";
+    const char* const kDeleteFlightSql = "DELETE FROM flights WHERE flight_number = ?";
+    const char* const kDeleteFlightPassengersSql = "DELETE FROM passengers WHERE flight_number = ?";
+    const char* const kDeletePassengerSql = "DELETE FROM passengers WHERE flight_number = ? AND seat_number = ?";
+    const char* const kUpdateSeatStatusSql =
+        "UPDATE seats SET status = ? WHERE flight_number = ? AND seat_number = ?";
+    const char* const kReleaseSeatSql =
+        "UPDATE seats SET status = ? WHERE flight_number = ? AND seat_number = ? AND status = ?";
+
+    QVariant nullableText(const QString& value) {
+        return value.isEmpty() ? QVariant(QMetaType::fromType<QString>()) : QVariant(value);
+    }
+}
+
+SQLiteDatabase::SQLiteDatabase()
+    : connections(QDir::currentPath() + "/flightmanagement.db")
+{
 }
 
 SQLiteDatabase::~SQLiteDatabase() {
-    if (connected) {
-        disconnect();
-    }
+    // The instance is a function-local static, destroyed after QCoreApplication, so
+    // closing here is too late; callers disconnect() first and the manager warns if not
 }
 
 SQLiteDatabase& SQLiteDatabase::getInstance() {
@@ -23,106 +66,516 @@ SQLiteDatabase& SQLiteDatabase::getInstance() {
 }
 
 bool SQLiteDatabase::connect() {
-    if (!connected) {
-        connected = db.open();
-        if (connected) {
-            initTables();
-        }
+    if (!connections.isOpen() && connections.open()) {
+        connections.write([this](QSqlDatabase& db) {
+            if (!initTables(db)) {
+                qWarning() << "Failed to initialize database schema";
+            }
+            return true;
+        });
     }
-    return connected;
+    return connections.isOpen();
 }
 
 void SQLiteDatabase::disconnect() {
-    if (connected) {
-        db.close();
-        connected = false;
+    if (connections.isOpen()) {
+        // Prepared statements must be released on the writer thread before it closes
+        connections.write([this](QSqlDatabase&) {
+            statements.clear();
+            return true;
+        });
+        connections.close();
     }
 }
 
 bool SQLiteDatabase::isConnected() const {
-    return connected;
+    return connections.isOpen();
+}
+
+QSqlQuery& SQLiteDatabase::statement(QSqlDatabase& db, const char* sql) {
+    const QString key = QString::fromLatin1(sql);
+    auto it = statements.find(key);
+    if (it == statements.end()) {
+        QSqlQuery query(db);
+        if (!query.prepare(key)) {
+            qWarning() << "Failed to prepare statement:" << query.lastError().text();
+        }
+        it = statements.insert(key, query);
+    }
+    return it.value();
+}
+
+// -----------------------------------------------------------------------------
+// Schema
+// -----------------------------------------------------------------------------
+
+bool SQLiteDatabase::migrateLegacyTables(QSqlDatabase& db) {
+    // Earlier versions kept each record as an opaque JSON blob in (id, data)
+    // tables. Keep them aside under a legacy name rather than dropping data.
+    // Each table is checked on its own; a missing one has nothing to migrate.
+    QSqlQuery query(db);
+    for (const QString table : {QStringLiteral("flights"), QStringLiteral("passengers")}) {
+        if (!query.exec(QString("SELECT COUNT(*) FROM pragma_table_info('%1') WHERE name = 'data'").arg(table))) {
+            return false;
+        }
+        const bool legacy = query.next() && query.value(0).toInt() > 0;
+        query.finish();
+        if (legacy && !query.exec(QString("ALTER TABLE %1 RENAME TO legacy_%1").arg(table))) {
+            return false;
+        }
+    }
+    return true;
 }
 
-bool SQLiteDatabase::initTables() {
-    QSqlQuery query;
-    
-    // Create flights table
-    bool success = query.exec(
+bool SQLiteDatabase::initTables(QSqlDatabase& db) {
+    QSqlQuery query(db);
+    if (!query.exec("PRAGMA user_version") || !query.next()) {
+        return false;
+    }
+    int version = query.value(0).toInt();
+    if (version == kSchemaVersion) {
+        return true;
+    }
+    if (version == 0 && !migrateLegacyTables(db)) {
+        return false;
+    }
+
+    const char* statements[] = {
         "CREATE TABLE IF NOT EXISTS flights ("
-        "id TEXT PRIMARY KEY,"
-        "data TEXT NOT NULL"
-        ")"
-    );
-    
-    // Create passengers table
-    if (success) {
-        success = query.exec(
-            "CREATE TABLE IF NOT EXISTS passengers ("
-            "id TEXT PRIMARY KEY,"
-            "data TEXT NOT NULL"
-            ")"
-        );
+        "flight_number TEXT PRIMARY KEY,"
+        "origin TEXT NOT NULL COLLATE NOCASE,"
+        "destination TEXT NOT NULL COLLATE NOCASE,"
+        "departure_time INTEGER NOT NULL,"  // seconds since the epoch, UTC
+        "base_price REAL NOT NULL,"
+        "seat_rows INTEGER NOT NULL,"
+        "seat_cols INTEGER NOT NULL"
+        ")",
+
+        "CREATE TABLE IF NOT EXISTS seats ("
+        "flight_number TEXT NOT NULL REFERENCES flights(flight_number) "
+        "ON DELETE CASCADE ON UPDATE CASCADE,"
+        "seat_number TEXT NOT NULL,"
+        "seat_class TEXT NOT NULL,"
+        "price REAL NOT NULL,"
+        "status INTEGER NOT NULL DEFAULT 0,"  // Seat::Status
+        "PRIMARY KEY (flight_number, seat_number)"
+        ") WITHOUT ROWID",
+
+        "CREATE TABLE IF NOT EXISTS passengers ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "flight_number TEXT NOT NULL REFERENCES flights(flight_number) "
+        "ON DELETE CASCADE ON UPDATE CASCADE,"
+        "first_name TEXT NOT NULL COLLATE NOCASE,"
+        "last_name TEXT NOT NULL COLLATE NOCASE,"
+        "phone TEXT NOT NULL,"
+        "email TEXT,"
+        "seat_number TEXT"
+        ")",
+
+        "CREATE INDEX IF NOT EXISTS idx_flights_route ON flights(origin, destination, departure_time)",
+        "CREATE INDEX IF NOT EXISTS idx_flights_departure ON flights(departure_time)",
+        "CREATE INDEX IF NOT EXISTS idx_seats_status ON seats(flight_number, status)",
+        "CREATE UNIQUE INDEX IF NOT EXISTS idx_passengers_seat ON passengers(flight_number, seat_number) "
+        "WHERE seat_number IS NOT NULL",
+        "CREATE INDEX IF NOT EXISTS idx_passengers_name ON passengers(last_name, first_name)",
+        "CREATE INDEX IF NOT EXISTS idx_passengers_first_name ON passengers(first_name)",
+        "CREATE INDEX IF NOT EXISTS idx_passengers_phone ON passengers(phone)",
+    };
+
+    if (!db.transaction()) {
+        return false;
+    }
+    for (const char* statement : statements) {
+        if (!query.exec(QString::fromLatin1(statement))) {
+            qWarning() << "Schema statement failed:" << query.lastError().text();
+            db.rollback();
+            return false;
+        }
     }
-    
-    return success;
+    query.exec(QString("PRAGMA user_version = %1").arg(kSchemaVersion));
+    return db.commit();
+}
+
+// -----------------------------------------------------------------------------
+// Whole-airline persistence
+// -----------------------------------------------------------------------------
+
+bool SQLiteDatabase::saveAirline(const Airline& airline) {
+    return connections.write([&](QSqlDatabase& db) {
+        if (!db.transaction()) {
+            return false;
+        }
+
+        QSqlQuery query(db);
+        // Flights that no longer exist take their seats and passengers with them
+        QSet<QString> keep;
+        for (const auto& flight : airline.getFlights()) {
+            if (!writeFlight(db, *flight)) {
+                db.rollback();
+                return false;
+            }
+            keep.insert(flight->getFlightNumber());
+        }
+        if (!query.exec("SELECT flight_number FROM flights")) {
+            db.rollback();
+            return false;
+        }
+        QStringList stale;
+        while (query.next()) {
+            QString flightNumber = query.value(0).toString();
+            if (!keep.contains(flightNumber))
+                stale << flightNumber;
+        }
+        if (!stale.isEmpty()) {
+            QSqlQuery& remove = statement(db, kDeleteFlightSql);
+            remove.bindValue(0, QVariantList(stale.begin(), stale.end()));
+            if (!remove.execBatch()) {
+                db.rollback();
+                return false;
+            }
+        }
+        return db.commit();
+    });
 }
 
-bool SQLiteDatabase::saveFlight(const QString& flightId, const QString& flightData) {
-    QSqlQuery query;
-    query.prepare("INSERT OR REPLACE INTO flights (id, data) VALUES (?, ?)");
-    query.addBindValue(flightId);
-    query.addBindValue(flightData);
-    return query.exec();
+bool SQLiteDatabase::loadAirline(Airline& airline) {
+    if (!connections.isOpen()) {
+        return false;
+    }
+
+    QSqlDatabase db = connections.reader();
+    // One read transaction so all three tables come from the same snapshot
+    db.transaction();
+
+    std::vector<std::unique_ptr<Flight>> flights;
+    QHash<QString, Flight*> byNumber;
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT flight_number, origin, destination, departure_time, base_price FROM flights")) {
+        db.rollback();
+        return false;
+    }
+    while (query.next()) {
+        auto flight = std::make_unique<Flight>(query.value(0).toString(),
+                                               query.value(1).toString(),
+                                               query.value(2).toString(),
+                                               QDateTime::fromSecsSinceEpoch(query.value(3).toLongLong()),
+                                               query.value(4).toDouble());
+        byNumber.insert(flight->getFlightNumber(), flight.get());
+        flights.push_back(std::move(flight));
+    }
+
+    // Stored prices and reserved/blocked states; occupancy follows from passengers
+    if (!query.exec("SELECT flight_number, seat_number, price, status FROM seats")) {
+        db.rollback();
+        return false;
+    }
+    while (query.next()) {
+        Flight* flight = byNumber.value(query.value(0).toString());
+        if (!flight) continue;
+        QString seatNumber = query.value(1).toString();
+        Seat* seat = flight->getSeat(seatNumber);
+        if (!seat) continue;
+        seat->setPrice(query.value(2).toDouble());
+        switch (static_cast<Seat::Status>(query.value(3).toInt())) {
+            case Seat::Status::Reserved: flight->reserveSeat(seatNumber); break;
+            case Seat::Status::Blocked: flight->blockSeat(seatNumber); break;
+            default: break;
+        }
+    }
+
+    if (!query.exec("SELECT flight_number, first_name, last_name, phone, email, seat_number "
+                    "FROM passengers ORDER BY id")) {
+        db.rollback();
+        return false;
+    }
+    while (query.next()) {
+        Flight* flight = byNumber.value(query.value(0).toString());
+        if (!flight) continue;
+        flight->addPassenger(std::make_unique<Passenger>(query.value(1).toString(),
+                                                         query.value(2).toString(),
+                                                         query.value(3).toString(),
+                                                         query.value(4).toString(),
+                                                         query.value(5).toString()));
+    }
+
+    query.finish();
+    db.commit();
+
+    airline.setFlights(std::move(flights));
+    airline.markClean();
+    return true;
 }
 
-bool SQLiteDatabase::updateFlight(const QString& flightId, const QString& flightData) {
-    return saveFlight(flightId, flightData);
+// -----------------------------------------------------------------------------
+// Row-level updates
+// -----------------------------------------------------------------------------
+
+bool SQLiteDatabase::writeFlight(QSqlDatabase& db, const Flight& flight) {
+    const QString flightNumber = flight.getFlightNumber();
+
+    QSqlQuery& upsertFlight = statement(db, kUpsertFlightSql);
+    upsertFlight.bindValue(0, flightNumber);
+    upsertFlight.bindValue(1, flight.getOrigin());
+    upsertFlight.bindValue(2, flight.getDestination());
+    upsertFlight.bindValue(3, flight.getDepartureTime().toSecsSinceEpoch());
+    upsertFlight.bindValue(4, flight.getBasePrice());
+    upsertFlight.bindValue(5, flight.getRows());
+    upsertFlight.bindValue(6, flight.getCols());
+    if (!upsertFlight.exec()) return false;
+
+    // All seats of the flight go down as one batch of bound arrays
+    const auto& seats = flight.getSeats();
+    QVariantList flightNumbers, seatNumbers, seatClasses, prices, statuses;
+    flightNumbers.reserve(seats.size());
+    seatNumbers.reserve(seats.size());
+    seatClasses.reserve(seats.size());
+    prices.reserve(seats.size());
+    statuses.reserve(seats.size());
+    for (const auto& [seatNumber, seat] : seats) {
+        flightNumbers << flightNumber;
+        seatNumbers << seatNumber;
+        seatClasses << seat->getSeatClass();
+        prices << seat->getPrice();
+        statuses << static_cast<int>(seat->getStatus());
+    }
+    QSqlQuery& upsertSeat = statement(db, kUpsertSeatSql);
+    upsertSeat.bindValue(0, flightNumbers);
+    upsertSeat.bindValue(1, seatNumbers);
+    upsertSeat.bindValue(2, seatClasses);
+    upsertSeat.bindValue(3, prices);
+    upsertSeat.bindValue(4, statuses);
+    if (!upsertSeat.execBatch()) return false;
+
+    QSqlQuery& clearPassengers = statement(db, kDeleteFlightPassengersSql);
+    clearPassengers.bindValue(0, flightNumber);
+    if (!clearPassengers.exec()) return false;
+
+    const auto passengers = flight.getAllPassengers();
+    return writePassengers(db, flightNumber, std::vector<const Passenger*>(passengers.begin(), passengers.end()));
 }
 
-QString SQLiteDatabase::loadFlight(const QString& flightId) {
-    QSqlQuery query;
-    query.prepare("SELECT data FROM flights WHERE id = ?");
-    query.addBindValue(flightId);
-    
-    if (query.exec() && query.next()) {
-        return query.value(0).toString();
+bool SQLiteDatabase::writePassengers(QSqlDatabase& db, const QString& flightNumber, const std::vector<const Passenger*>& passengers) {
+    if (passengers.empty()) return true;
+
+    QVariantList flightNumbers, firstNames, lastNames, phones, emails, seatNumbers;
+    for (const Passenger* passenger : passengers) {
+        flightNumbers << flightNumber;
+        firstNames << passenger->getFirstName();
+        lastNames << passenger->getLastName();
+        phones << passenger->getPhoneNumber();
+        emails << passenger->getEmail();
+        seatNumbers << nullableText(passenger->getSeatNumber());
     }
-    return QString();
+    QSqlQuery& insert = statement(db, kUpsertPassengerSql);
+    insert.bindValue(0, flightNumbers);
+    insert.bindValue(1, firstNames);
+    insert.bindValue(2, lastNames);
+    insert.bindValue(3, phones);
+    insert.bindValue(4, emails);
+    insert.bindValue(5, seatNumbers);
+    return insert.execBatch();
+}
+
+bool SQLiteDatabase::saveFlight(const Flight& flight) {
+    return connections.write([&](QSqlDatabase& db) {
+        if (!db.transaction()) {
+            return false;
+        }
+        if (!writeFlight(db, flight)) {
+            db.rollback();
+            return false;
+        }
+        return db.commit();
+    });
+}
+
+bool SQLiteDatabase::saveFlights(const std::vector<Flight*>& flights) {
+    return connections.write([&](QSqlDatabase& db) {
+        if (!db.transaction()) {
+            return false;
+        }
+        for (const Flight* flight : flights) {
+            if (!writeFlight(db, *flight)) {
+                db.rollback();
+                return false;
+            }
+        }
+        return db.commit();
+    });
+}
+
+bool SQLiteDatabase::deleteFlight(const QString& flightNumber) {
+    return connections.write([&](QSqlDatabase& db) {
+        QSqlQuery& query = statement(db, kDeleteFlightSql);
+        query.bindValue(0, flightNumber);
+        return query.exec();
+    });
+}
+
+bool SQLiteDatabase::updateSeatStatus(const QString& flightNumber, const QString& seatNumber, Seat::Status status) {
+    return connections.write([&](QSqlDatabase& db) {
+        QSqlQuery& query = statement(db, kUpdateSeatStatusSql);
+        query.bindValue(0, static_cast<int>(status));
+        query.bindValue(1, flightNumber);
+        query.bindValue(2, seatNumber);
+        return query.exec() && query.numRowsAffected() == 1;
+    });
+}
+
+bool SQLiteDatabase::savePassenger(const QString& flightNumber, const Passenger& passenger) {
+    return savePassengers(flightNumber, {&passenger});
 }
 
-bool SQLiteDatabase::deleteFlight(const QString& flightId) {
-    QSqlQuery query;
-    query.prepare("DELETE FROM flights WHERE id = ?");
-    query.addBindValue(flightId);
-    return query.exec();
+bool SQLiteDatabase::updatePassenger(const QString& flightNumber, const Passenger& passenger) {
+    return savePassenger(flightNumber, passenger);
 }
 
-bool SQLiteDatabase::savePassenger(const QString& passengerId, const QString& passengerData) {
-    QSqlQuery query;
-    query.prepare("INSERT OR REPLACE INTO passengers (id, data) VALUES (?, ?)");
-    query.addBindValue(passengerId);
-    query.addBindValue(passengerData);
-    return query.exec();
+bool SQLiteDatabase::savePassengers(const QString& flightNumber, const std::vector<const Passenger*>& passengers) {
+    return connections.write([&](QSqlDatabase& db) {
+        if (!db.transaction()) {
+            return false;
+        }
+
+        bool ok = writePassengers(db, flightNumber, passengers);
+
+        // Mark the booked seats occupied in one more batch
+        QVariantList statuses, flightNumbers, seatNumbers;
+        for (const Passenger* passenger : passengers) {
+            if (!passenger->hasSeat()) continue;
+            statuses << static_cast<int>(Seat::Status::Occupied);
+            flightNumbers << flightNumber;
+            seatNumbers << passenger->getSeatNumber();
+        }
+        if (ok && !seatNumbers.isEmpty()) {
+            QSqlQuery& update = statement(db, kUpdateSeatStatusSql);
+            update.bindValue(0, statuses);
+            update.bindValue(1, flightNumbers);
+            update.bindValue(2, seatNumbers);
+            ok = update.execBatch();
+        }
+        if (!ok) {
+            db.rollback();
+            return false;
+        }
+        return db.commit();
+    });
+}
+
+bool SQLiteDatabase::deletePassenger(const QString& flightNumber, const QString& seatNumber) {
+    return connections.write([&](QSqlDatabase& db) {
+        if (!db.transaction()) {
+            return false;
+        }
+
+        QSqlQuery& remove = statement(db, kDeletePassengerSql);
+        remove.bindValue(0, flightNumber);
+        remove.bindValue(1, seatNumber);
+        bool ok = remove.exec();
+
+        if (ok) {
+            // Only an occupied seat is freed; reserved or blocked seats keep their state
+            QSqlQuery& release = statement(db, kReleaseSeatSql);
+            release.bindValue(0, static_cast<int>(Seat::Status::Available));
+            release.bindValue(1, flightNumber);
+            release.bindValue(2, seatNumber);
+            release.bindValue(3, static_cast<int>(Seat::Status::Occupied));
+            ok = release.exec();
+        }
+        if (!ok) {
+            db.rollback();
+            return false;
+        }
+        return db.commit();
+    });
+}
+
+// -----------------------------------------------------------------------------
+// Queries
+//
+// These run on the calling thread's reader connection, so reports and searches
+// may be issued from worker threads while bookings are being written.
+// -----------------------------------------------------------------------------
+
+QStringList SQLiteDatabase::searchFlights(const QString& query) {
+    QStringList results;
+    QSqlQuery sql(connections.reader());
+    sql.setForwardOnly(true);
+    sql.prepare("SELECT flight_number FROM flights "
+                "WHERE flight_number LIKE ? OR origin LIKE ? OR destination LIKE ? "
+                "ORDER BY departure_time");
+    QString pattern = "%" + query + "%";
+    sql.addBindValue(pattern);
+    sql.addBindValue(pattern);
+    sql.addBindValue(pattern);
+    if (sql.exec()) {
+        while (sql.next())
+            results << sql.value(0).toString();
+    }
+    return results;
+}
+
+QStringList SQLiteDatabase::searchFlightsByRoute(const QString& origin, const QString& destination,
+                                                 const QDateTime& from, const QDateTime& to) {
+    // Served by idx_flights_route
+    QStringList results;
+    QSqlQuery sql(connections.reader());
+    sql.setForwardOnly(true);
+    sql.prepare("SELECT flight_number FROM flights "
+                "WHERE origin = ? AND destination = ? AND departure_time BETWEEN ? AND ? "
+                "ORDER BY departure_time");
+    sql.addBindValue(origin);
+    sql.addBindValue(destination);
+    sql.addBindValue(from.toSecsSinceEpoch());
+    sql.addBindValue(to.toSecsSinceEpoch());
+    if (sql.exec()) {
+        while (sql.next())
+            results << sql.value(0).toString();
+    }
+    return results;
 }
 
-bool SQLiteDatabase::updatePassenger(const QString& passengerId, const QString& passengerData) {
-    return savePassenger(passengerId, passengerData);
+std::vector<PassengerRecord> SQLiteDatabase::searchPassengers(const QString& query) {
+    // Prefix matches so the name and phone indexes can be used
+    std::vector<PassengerRecord> results;
+    QSqlQuery sql(connections.reader());
+    sql.setForwardOnly(true);
+    sql.prepare("SELECT flight_number, first_name, last_name, phone, email, seat_number FROM passengers "
+                "WHERE last_name LIKE ? OR first_name LIKE ? OR phone LIKE ?");
+    QString pattern = query + "%";
+    sql.addBindValue(pattern);
+    sql.addBindValue(pattern);
+    sql.addBindValue(pattern);
+    if (sql.exec()) {
+        while (sql.next()) {
+            results.push_back({sql.value(0).toString(), sql.value(1).toString(), sql.value(2).toString(),
+                               sql.value(3).toString(), sql.value(4).toString(), sql.value(5).toString()});
+        }
+    }
+    return results;
 }
 
-QString SQLiteDatabase::loadPassenger(const QString& passengerId) {
-    QSqlQuery query;
-    query.prepare("SELECT data FROM passengers WHERE id = ?");
-    query.addBindValue(passengerId);
-    
-    if (query.exec() && query.next()) {
-        return query.value(0).toString();
+int SQLiteDatabase::occupiedSeatCount(const QString& flightNumber) {
+    QSqlQuery sql(connections.reader());
+    sql.prepare("SELECT COUNT(*) FROM seats WHERE flight_number = ? AND status = ?");
+    sql.addBindValue(flightNumber);
+    sql.addBindValue(static_cast<int>(Seat::Status::Occupied));
+    if (sql.exec() && sql.next()) {
+        return sql.value(0).toInt();
     }
-    return QString();
+    return 0;
 }
 
-bool SQLiteDatabase::deletePassenger(const QString& passengerId) {
-    QSqlQuery query;
-    query.prepare("DELETE FROM passengers WHERE id = ?");
-    query.addBindValue(passengerId);
-    return query.exec();
-} 
\ No newline at end of file
+QMap<QString, int> SQLiteDatabase::occupancyByFlight() {
+    QMap<QString, int> counts;
+    QSqlQuery sql(connections.reader());
+    sql.setForwardOnly(true);
+    sql.prepare("SELECT flight_number, COUNT(*) FROM seats WHERE status = ? GROUP BY flight_number");
+    sql.addBindValue(static_cast<int>(Seat::Status::Occupied));
+    if (sql.exec()) {
+        while (sql.next())
+            counts.insert(sql.value(0).toString(), sql.value(1).toInt());
+    }
+    return counts;
+}
@@ -0,0 +1,121 @@
+// This file contains the implementation for the `SeatStateCodec` class.
+// Prices are stored in whole cents as unsigned LEB128 varints; seats of one class
+// differ from the class minimum by a few hundred currency units at most, so most
+// deltas take two or three bytes instead of an eight-byte double.
+
+#include "database/SeatStateCodec.h"
+#include "models/Flight.h"
+#include <QHash>
+#include <cmath>
+
+namespace {
+    constexpr int kMaxClasses = 4;  // Two bits of class index per seat
+
+    void writeVarint(QByteArray& out, quint64 value) {
+        while (value >= 0x80) {
+            out.append(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.append(static_cast<char>(value));
+    }
+
+    bool readVarint(const QByteArray& in, qsizetype& pos, quint64& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && pos < in.size(); shift += 7) {
+            const quint8 byte = static_cast<quint8>(in[pos++]);
+            value |= quint64(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    quint64 zigzag(qint64 value) {
+        return (quint64(value) << 1) ^ quint64(value >> 63);
+    }
+
+    qint64 unzigzag(quint64 value) {
+        return qint64(value >> 1) ^ -qint64(value & 1);
+    }
+
+    qint64 toCents(double price) {
+        return std::llround(price * 100.0);
+    }
+}
+
+SeatStateCodec::Encoded SeatStateCodec::encode(const Flight& flight) {
+    const std::vector<Seat*> seats = flight.getSeatsInLayoutOrder();
+
+    // Class indexes follow first appearance in the layout
+    QHash<QString, int> classIndex;
+    std::vector<qint64> bases;
+    std::vector<int> seatClasses;
+    seatClasses.reserve(seats.size());
+    for (const Seat* seat : seats) {
+        const qint64 cents = toCents(seat->getPrice());
+        int index = classIndex.value(seat->getSeatClass(), -1);
+        if (index < 0) {
+            if (bases.size() == size_t(kMaxClasses)) return {};
+            index = static_cast<int>(bases.size());
+            classIndex.insert(seat->getSeatClass(), index);
+            bases.push_back(cents);
+        }
+        seatClasses.push_back(index);
+        bases[index] = qMin(bases[index], cents);
+    }
+
+    Encoded encoded;
+    encoded.status.reserve(10 + (seats.size() + 1) / 2);
+    writeVarint(encoded.status, seats.size());
+    for (size_t i = 0; i < seats.size(); i += 2) {
+        quint8 packed = static_cast<quint8>(seats[i]->getStatus()) | (seatClasses[i] << 2);
+        if (i + 1 < seats.size())
+            packed |= (static_cast<quint8>(seats[i + 1]->getStatus()) | (seatClasses[i + 1] << 2)) << 4;
+        encoded.status.append(static_cast<char>(packed));
+    }
+
+    encoded.prices.reserve(10 + bases.size() * 4 + seats.size() * 2);
+    writeVarint(encoded.prices, bases.size());
+    for (qint64 base : bases)
+        writeVarint(encoded.prices, zigzag(base));
+    for (size_t i = 0; i < seats.size(); ++i)
+        writeVarint(encoded.prices, quint64(toCents(seats[i]->getPrice()) - bases[seatClasses[i]]));
+    return encoded;
+}
+
+bool SeatStateCodec::decode(const QByteArray& status, const QByteArray& prices,
+                            std::vector<Seat::Status>& statuses, std::vector<double>& seatPrices) {
+    qsizetype pos = 0;
+    quint64 seatCount = 0;
+    if (!readVarint(status, pos, seatCount) || quint64(status.size() - pos) != (seatCount + 1) / 2) {
+        return false;
+    }
+
+    std::vector<int> seatClasses;
+    seatClasses.reserve(seatCount);
+    statuses.clear();
+    statuses.reserve(seatCount);
+    for (quint64 i = 0; i < seatCount; ++i) {
+        const quint8 nibble = (static_cast<quint8>(status[pos + qsizetype(i / 2)]) >> ((i % 2) * 4)) & 0x0F;
+        statuses.push_back(static_cast<Seat::Status>(nibble & 0x03));
+        seatClasses.push_back(nibble >> 2);
+    }
+
+    pos = 0;
+    quint64 classCount = 0;
+    if (!readVarint(prices, pos, classCount) || classCount > kMaxClasses) return false;
+    qint64 bases[kMaxClasses] = {};
+    for (quint64 c = 0; c < classCount; ++c) {
+        quint64 raw = 0;
+        if (!readVarint(prices, pos, raw)) return false;
+        bases[c] = unzigzag(raw);
+    }
+
+    seatPrices.clear();
+    seatPrices.reserve(seatCount);
+    for (quint64 i = 0; i < seatCount; ++i) {
+        quint64 delta = 0;
+        if (quint64(seatClasses[i]) >= classCount || !readVarint(prices, pos, delta)) return false;
+        seatPrices.push_back(double(bases[seatClasses[i]] + qint64(delta)) / 100.0);
+    }
+    return pos == prices.size();
+}
@@ -0,0 +1,308 @@
+// This file contains the implementation for the `SnapshotView` class.
+// The writer flattens flights and passengers into fixed-size records and a
+// deduplicated UTF-16 string table; the reader maps the file and answers queries
+// by binary search and linear scans over the mapped records.
+
+#include "database/SnapshotView.h"
+#include <QSaveFile>
+#include <QHash>
+#include <QSysInfo>
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace {
+    constexpr char kMagic[4] = {'F', 'O', 'M', 'B'};
+    constexpr quint32 kFormatVersion = 1;
+
+    struct FileHeader {
+        char magic[4];
+        quint32 version;
+        quint32 flightCount;
+        quint32 passengerCount;
+        quint64 flightOffset;
+        quint64 passengerOffset;
+        quint64 stringOffset;
+        quint64 stringCount;  // UTF-16 code units
+    };
+
+    static_assert(sizeof(FileHeader) == 48, "FileHeader layout is part of the file format");
+    static_assert(sizeof(SnapshotView::FlightRecord) == 64, "FlightRecord layout is part of the file format");
+    static_assert(sizeof(SnapshotView::PassengerRecord) == 48, "PassengerRecord layout is part of the file format");
+
+    // Records are written and read in host layout, which the format fixes as little endian
+    constexpr bool kHostIsLittleEndian = QSysInfo::ByteOrder == QSysInfo::LittleEndian;
+
+    quint64 alignTo8(quint64 offset) {
+        return (offset + 7) & ~quint64(7);
+    }
+
+    /**
+     * @brief Deduplicating UTF-16 string table
+     */
+    class StringTable {
+    public:
+        SnapshotView::StringRef add(const QString& value) {
+            auto it = refs.constFind(value);
+            if (it != refs.constEnd()) return it.value();
+            SnapshotView::StringRef ref{static_cast<quint32>(units.size()), static_cast<quint32>(value.size())};
+            units.append(value);
+            refs.insert(value, ref);
+            return ref;
+        }
+        const QString& data() const { return units; }
+
+    private:
+        QString units;
+        QHash<QString, SnapshotView::StringRef> refs;
+    };
+}
+
+SnapshotView::~SnapshotView() {
+    close();
+}
+
+// -----------------------------------------------------------------------------
+// Writing
+// -----------------------------------------------------------------------------
+
+bool SnapshotView::write(const QString& filename, const std::vector<std::unique_ptr<Flight>>& flights) {
+    if (!kHostIsLittleEndian) {
+        return false;
+    }
+
+    // Sorted by flight number so lookups can binary search the mapped records
+    std::vector<size_t> order(flights.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return flights[a]->getFlightNumber() < flights[b]->getFlightNumber();
+    });
+
+    StringTable strings;
+    std::vector<FlightRecord> flightRecords;
+    std::vector<PassengerRecord> passengerRecords;
+    flightRecords.reserve(flights.size());
+    for (size_t index : order) {
+        const Flight& flight = *flights[index];
+        const auto passengers = flight.getAllPassengers();
+
+        FlightRecord record{};
+        record.flightNumber = strings.add(flight.getFlightNumber());
+        record.origin = strings.add(flight.getOrigin());
+        record.destination = strings.add(flight.getDestination());
+        record.departureMsecs = flight.getDepartureTime().toMSecsSinceEpoch();
+        record.basePrice = flight.getBasePrice();
+        record.firstPassenger = static_cast<quint32>(passengerRecords.size());
+        record.passengerCount = static_cast<quint32>(passengers.size());
+        record.occupiedSeats = static_cast<quint32>(flight.getOccupiedSeats());
+        record.totalSeats = static_cast<quint32>(flight.getSeats().size());
+        record.revenue = flight.calculateRevenue();
+
+        for (const Passenger* passenger : passengers) {
+            PassengerRecord entry{};
+            entry.firstName = strings.add(passenger->getFirstName());
+            entry.lastName = strings.add(passenger->getLastName());
+            entry.phoneNumber = strings.add(passenger->getPhoneNumber());
+            entry.email = strings.add(passenger->getEmail());
+            entry.seatNumber = strings.add(passenger->getSeatNumber());
+            entry.flight = static_cast<quint32>(flightRecords.size());
+            passengerRecords.push_back(entry);
+        }
+        flightRecords.push_back(record);
+    }
+
+    FileHeader header{};
+    std::copy(std::begin(kMagic), std::end(kMagic), header.magic);
+    header.version = kFormatVersion;
+    header.flightCount = static_cast<quint32>(flightRecords.size());
+    header.passengerCount = static_cast<quint32>(passengerRecords.size());
+    header.flightOffset = alignTo8(sizeof(FileHeader));
+    header.passengerOffset = alignTo8(header.flightOffset + flightRecords.size() * sizeof(FlightRecord));
+    header.stringOffset = alignTo8(header.passengerOffset + passengerRecords.size() * sizeof(PassengerRecord));
+    header.stringCount = static_cast<quint64>(strings.data().size());
+
+    QByteArray image(static_cast<qsizetype>(header.stringOffset + header.stringCount * sizeof(char16_t)), '\0');
+    char* out = image.data();
+    std::memcpy(out, &header, sizeof(header));
+    if (!flightRecords.empty())
+        std::memcpy(out + header.flightOffset, flightRecords.data(), flightRecords.size() * sizeof(FlightRecord));
+    if (!passengerRecords.empty())
+        std::memcpy(out + header.passengerOffset, passengerRecords.data(),
+                    passengerRecords.size() * sizeof(PassengerRecord));
+    std::memcpy(out + header.stringOffset, strings.data().utf16(), header.stringCount * sizeof(char16_t));
+
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(image);
+    return file.commit();
+}
+
+// -----------------------------------------------------------------------------
+// Mapping
+// -----------------------------------------------------------------------------
+
+bool SnapshotView::open(const QString& filename) {
+    close();
+    if (!kHostIsLittleEndian) {
+        return false;
+    }
+
+    file.setFileName(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const quint64 size = static_cast<quint64>(file.size());
+    if (size < sizeof(FileHeader)) {
+        close();
+        return false;
+    }
+    const uchar* mapped = file.map(0, file.size());
+    if (!mapped) {
+        close();
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, mapped, sizeof(header));
+    const bool valid = std::equal(std::begin(kMagic), std::end(kMagic), header.magic)
+        && header.version == kFormatVersion
+        && header.flightOffset % 8 == 0 && header.passengerOffset % 8 == 0 && header.stringOffset % 8 == 0
+        // Divide rather than multiply: a damaged header must not wrap past the check
+        && header.flightOffset <= size
+        && header.flightCount <= (size - header.flightOffset) / sizeof(FlightRecord)
+        && header.passengerOffset <= size
+        && header.passengerCount <= (size - header.passengerOffset) / sizeof(PassengerRecord)
+        && header.stringOffset <= size
+        && header.stringCount <= (size - header.stringOffset) / sizeof(char16_t);
+    if (!valid) {
+        file.unmap(const_cast<uchar*>(mapped));
+        close();
+        return false;
+    }
+
+    data = mapped;
+    flightRecords = reinterpret_cast<const FlightRecord*>(data + header.flightOffset);
+    passengerRecords = reinterpret_cast<const PassengerRecord*>(data + header.passengerOffset);
+    strings = reinterpret_cast<const char16_t*>(data + header.stringOffset);
+    flightTotal = header.flightCount;
+    passengerTotal = header.passengerCount;
+    stringTotal = header.stringCount;
+    return true;
+}
+
+void SnapshotView::close() {
+    if (data) {
+        file.unmap(const_cast<uchar*>(data));
+    }
+    file.close();
+    data = nullptr;
+    flightRecords = nullptr;
+    passengerRecords = nullptr;
+    strings = nullptr;
+    flightTotal = passengerTotal = 0;
+    stringTotal = 0;
+}
+
+QStringView SnapshotView::text(StringRef ref) const {
+    // Out-of-range references from a damaged file read as empty strings
+    if (quint64(ref.offset) + ref.length > stringTotal) return {};
+    return QStringView(strings + ref.offset, ref.length);
+}
+
+const SnapshotView::FlightRecord* SnapshotView::findFlight(QStringView flightNumber) const {
+    const FlightRecord* end = flightRecords + flightTotal;
+    const FlightRecord* it = std::lower_bound(flightRecords, end, flightNumber,
+        [this](const FlightRecord& record, QStringView key) { return text(record.flightNumber) < key; });
+    return it != end && text(it->flightNumber) == flightNumber ? it : nullptr;
+}
+
+FlightSummary SnapshotView::summarize(const FlightRecord& record) const {
+    FlightSummary summary;
+    summary.flightNumber = text(record.flightNumber).toString();
+    summary.origin = text(record.origin).toString();
+    summary.destination = text(record.destination).toString();
+    summary.departureTime = QDateTime::fromMSecsSinceEpoch(record.departureMsecs);
+    summary.passengerCount = static_cast<int>(record.passengerCount);
+    summary.occupiedSeats = static_cast<int>(record.occupiedSeats);
+    summary.totalSeats = static_cast<int>(record.totalSeats);
+    summary.revenue = record.revenue;
+    return summary;
+}
+
+PassengerSummary SnapshotView::summarize(const PassengerRecord& record) const {
+    const QStringView flightNumber = record.flight < flightTotal
+        ? text(flightRecords[record.flight].flightNumber) : QStringView();
+    return {flightNumber.toString(), text(record.firstName).toString(), text(record.lastName).toString(),
+            text(record.phoneNumber).toString(), text(record.email).toString(), text(record.seatNumber).toString()};
+}
+
+// -----------------------------------------------------------------------------
+// Queries
+// -----------------------------------------------------------------------------
+
+int SnapshotView::flightCount() const {
+    return static_cast<int>(flightTotal);
+}
+
+std::vector<FlightSummary> SnapshotView::allFlights() const {
+    std::vector<FlightSummary> results;
+    results.reserve(flightTotal);
+    for (quint32 i = 0; i < flightTotal; ++i)
+        results.push_back(summarize(flightRecords[i]));
+    return results;
+}
+
+std::optional<FlightSummary> SnapshotView::getFlight(const QString& flightNumber) const {
+    if (const FlightRecord* record = findFlight(flightNumber))
+        return summarize(*record);
+    return std::nullopt;
+}
+
+std::vector<FlightSummary> SnapshotView::searchFlights(const QString& query) const {
+    std::vector<FlightSummary> results;
+    for (quint32 i = 0; i < flightTotal; ++i) {
+        const FlightRecord& record = flightRecords[i];
+        if (text(record.flightNumber).contains(query, Qt::CaseInsensitive) ||
+            text(record.origin).contains(query, Qt::CaseInsensitive) ||
+            text(record.destination).contains(query, Qt::CaseInsensitive)) {
+            results.push_back(summarize(record));
+        }
+    }
+    return results;
+}
+
+std::vector<PassengerSummary> SnapshotView::searchPassengers(const QString& query) const {
+    std::vector<PassengerSummary> results;
+    for (quint32 i = 0; i < passengerTotal; ++i) {
+        const PassengerRecord& record = passengerRecords[i];
+        if (text(record.firstName).contains(query, Qt::CaseInsensitive) ||
+            text(record.lastName).contains(query, Qt::CaseInsensitive) ||
+            text(record.phoneNumber).contains(query)) {
+            results.push_back(summarize(record));
+        }
+    }
+    return results;
+}
+
+std::vector<PassengerSummary> SnapshotView::passengers(const QString& flightNumber) const {
+    std::vector<PassengerSummary> results;
+    const FlightRecord* flight = findFlight(flightNumber);
+    if (!flight) return results;
+
+    const quint32 end = qMin(passengerTotal, flight->firstPassenger + flight->passengerCount);
+    for (quint32 i = flight->firstPassenger; i < end; ++i)
+        results.push_back(summarize(passengerRecords[i]));
+    return results;
+}
+
+int SnapshotView::occupiedSeats(const QString& flightNumber) const {
+    const FlightRecord* record = findFlight(flightNumber);
+    return record ? static_cast<int>(record->occupiedSeats) : 0;
+}
+
+double SnapshotView::revenue(const QString& flightNumber) const {
+    const FlightRecord* record = findFlight(flightNumber);
+    return record ? record->revenue : 0.0;
+}
@@ -0,0 +1,170 @@
+// This file contains the implementation for the `FlightListModel` class.
+// Flight headers carry everything the list shows, so formatting a row never loads
+// a lazily stored flight. Change events trigger a diff against the airline, which
+// turns the usual add, remove or edit into a single row insert, remove or update.
+
+#include "gui/FlightListModel.h"
+#include "models/Airline.h"
+#include "models/Flight.h"
+#include <QSet>
+#include <QTimer>
+#include <algorithm>
+
+namespace {
+    constexpr int kPollIntervalMs = 100;
+}
+
+FlightListModel::FlightListModel(const Airline& airline, QObject* parent)
+    : QAbstractListModel(parent)
+    , airline(airline)
+    , cursor(airline.changeFeed().subscribe())
+    , pollTimer(new QTimer(this))
+{
+    connect(pollTimer, &QTimer::timeout, this, &FlightListModel::sync);
+    pollTimer->start(kPollIntervalMs);
+    reload();
+}
+
+int FlightListModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(rows.size());
+}
+
+QVariant FlightListModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= static_cast<int>(rows.size())) return QVariant();
+    const Row& row = rows[index.row()];
+    if (role == Qt::UserRole) return row.flightNumber;
+    if (role != Qt::DisplayRole) return QVariant();
+
+    if (row.display.isEmpty()) {
+        if (const Flight* flight = flightAt(index.row())) row.display = format(*flight);
+    }
+    return row.display;
+}
+
+QString FlightListModel::flightNumberAt(int row) const {
+    return row >= 0 && row < static_cast<int>(rows.size()) ? rows[row].flightNumber : QString();
+}
+
+int FlightListModel::rowOf(const QString& flightNumber) const {
+    if (!rowIndexValid) {
+        rowIndex.clear();
+        rowIndex.reserve(static_cast<qsizetype>(rows.size()));
+        for (size_t i = 0; i < rows.size(); ++i)
+            rowIndex.insert(rows[i].flightNumber, static_cast<int>(i));
+        rowIndexValid = true;
+    }
+    return rowIndex.value(flightNumber, -1);
+}
+
+const Flight* FlightListModel::flightAt(int row) const {
+    // Rows mirror the airline's order, so the same index is almost always right
+    const auto& flights = airline.getFlights();
+    const QString& flightNumber = rows[row].flightNumber;
+    if (row < static_cast<int>(flights.size()) && flights[row]->getFlightNumber() == flightNumber) {
+        return flights[row].get();
+    }
+    auto it = std::find_if(flights.begin(), flights.end(),
+                           [&](const auto& f) { return f->getFlightNumber() == flightNumber; });
+    return it != flights.end() ? it->get() : nullptr;
+}
+
+QString FlightListModel::format(const Flight& flight) {
+    return QString("%1 - %2 to %3 (%4)")
+        .arg(flight.getFlightNumber(), flight.getOrigin(), flight.getDestination(),
+             flight.getDepartureTime().toString("yyyy-MM-dd hh:mm"));
+}
+
+// -----------------------------------------------------------------------------
+// Change tracking
+// -----------------------------------------------------------------------------
+
+void FlightListModel::reload() {
+    beginResetModel();
+    cursor = airline.changeFeed().subscribe();
+    rows.clear();
+    rowIndexValid = false;
+    rows.reserve(airline.getFlights().size());
+    for (const auto& flight : airline.getFlights())
+        rows.push_back({flight->getFlightNumber(), QString()});
+    endResetModel();
+}
+
+void FlightListModel::sync() {
+    events.clear();
+    if (cursor.poll(events) == ChangeFeed::Cursor::Status::Overrun) {
+        reload();
+        return;
+    }
+
+    // Events only say that the flight set changed; the rows are keyed from the
+    // airline itself, never from event text
+    bool flightsChanged = false;
+    QSet<QString> edited;
+    for (const ChangeEvent& event : events) {
+        switch (event.type) {
+        case ChangeEvent::Type::FlightsReset:
+            reload();
+            return;
+        case ChangeEvent::Type::FlightAdded:
+        case ChangeEvent::Type::FlightRemoved:
+            flightsChanged = true;
+            break;
+        case ChangeEvent::Type::FlightUpdated:
+            flightsChanged = true;
+            edited.insert(event.flight());
+            break;
+        default:
+            // Seat and passenger changes do not affect the list text
+            break;
+        }
+    }
+    if (flightsChanged) reconcile();
+    // An edit may keep the number but change the schedule; renumbered rows were
+    // already replaced by reconcile()
+    for (const QString& flightNumber : std::as_const(edited)) {
+        const int row = rowOf(flightNumber);
+        if (row < 0) continue;
+        rows[row].display.clear();
+        emit dataChanged(index(row), index(row));
+    }
+}
+
+void FlightListModel::reconcile() {
+    // Airline keeps flights in insertion order, so the usual add, remove or edit
+    // is one contiguous run between a common prefix and suffix
+    const auto& flights = airline.getFlights();
+    size_t prefix = 0;
+    while (prefix < rows.size() && prefix < flights.size()
+           && rows[prefix].flightNumber == flights[prefix]->getFlightNumber()) ++prefix;
+    size_t suffix = 0;
+    while (suffix < rows.size() - prefix && suffix < flights.size() - prefix
+           && rows[rows.size() - 1 - suffix].flightNumber
+                  == flights[flights.size() - 1 - suffix]->getFlightNumber()) ++suffix;
+
+    const size_t removed = rows.size() - prefix - suffix;
+    const size_t inserted = flights.size() - prefix - suffix;
+    if (removed > 0 || inserted > 0) rowIndexValid = false;
+
+    // Rows replaced in place keep their position, e.g. a flight renumbered by an edit
+    const size_t replaced = qMin(removed, inserted);
+    for (size_t i = prefix; i < prefix + replaced; ++i) {
+        rows[i] = {flights[i]->getFlightNumber(), QString()};
+    }
+    if (replaced > 0) {
+        emit dataChanged(index(static_cast<int>(prefix)), index(static_cast<int>(prefix + replaced) - 1));
+    }
+
+    const int first = static_cast<int>(prefix + replaced);
+    if (removed > replaced) {
+        beginRemoveRows(QModelIndex(), first, first + static_cast<int>(removed - replaced) - 1);
+        rows.erase(rows.begin() + first, rows.begin() + first + static_cast<int>(removed - replaced));
+        endRemoveRows();
+    } else if (inserted > replaced) {
+        beginInsertRows(QModelIndex(), first, first + static_cast<int>(inserted - replaced) - 1);
+        std::vector<Row> added;
+        for (size_t i = first; i < prefix + inserted; ++i)
+            added.push_back({flights[i]->getFlightNumber(), QString()});
+        rows.insert(rows.begin() + first, added.begin(), added.end());
+        endInsertRows();
+    }
+}
@@ -0,0 +1,282 @@
+// This file contains the implementation for the `FlightPrintRenderer` class.
+// Each flight yields two independent jobs, its seat map and its manifest, so long
+// manifests and quick seat maps balance across the global thread pool. Workers only
+// see the snapshots, the shared cabin geometry and their own paint device, all held
+// by a render state that lives as long as the mapping does.
+
+#include "gui/FlightPrintRenderer.h"
+#include "gui/SeatMapGeometry.h"
+#include "gui/SeatMapWidget.h"
+#include "models/Passenger.h"
+#include <QDir>
+#include <QSaveFile>
+#include <QImage>
+#include <QPainter>
+#include <QPdfWriter>
+#include <QPageSize>
+#include <QPageLayout>
+#include <QFontMetrics>
+#include <QFontDatabase>
+#include <QPromise>
+#include <QRegularExpression>
+#include <QSet>
+#include <QDebug>
+#include <QtConcurrent/QtConcurrentMap>
+#include <algorithm>
+#include <climits>
+
+namespace {
+    constexpr qreal kSeatMapScale = 2.0;  // Image pixels per scene unit, for print sharpness
+    constexpr int kSeatMapMargin = 24;
+    constexpr int kSeatMapHeader = 56;
+    constexpr int kManifestResolution = 150;
+
+    struct ManifestLine {
+        int order = INT_MAX;  // Geometry index of the seat; unknown seats sort last
+        QString seat;
+        QString seatClass;
+        QString lastName;
+        QString firstName;
+        QString phone;
+    };
+
+    // Everything a page needs, copied off the model before the workers start
+    struct FlightSheet {
+        QString flightNumber;
+        QString fileStem;  // Unique among the flights rendered together
+        QString title;
+        QVector<SeatState> states;
+        QVector<ManifestLine> manifest;
+    };
+
+    struct RenderJob {
+        const FlightSheet* sheet = nullptr;
+        bool manifest = false;
+    };
+
+    struct RenderState {
+        QDir dir;
+        std::shared_ptr<const SeatMapGeometry> geometry;
+        std::vector<FlightSheet> sheets;
+        std::vector<RenderJob> jobs;  // Point into `sheets`
+    };
+
+    FlightSheet makeSheet(const Flight& flight, const SeatMapGeometry& geometry) {
+        FlightSheet sheet;
+        sheet.flightNumber = flight.getFlightNumber();
+        sheet.title = QString("Flight %1  %2 - %3  %4")
+                          .arg(flight.getFlightNumber(), flight.getOrigin(), flight.getDestination(),
+                               flight.getDepartureTime().toString("yyyy-MM-dd hh:mm"));
+        sheet.states = geometry.statesFor(flight);
+
+        for (const Passenger* passenger : flight.getAllPassengers()) {
+            ManifestLine line;
+            line.seat = passenger->getSeatNumber();
+            const int index = geometry.indexOf(line.seat);
+            if (index >= 0) {
+                line.order = index;
+                line.seatClass = geometry.seats()[index].seatClass;
+            }
+            line.lastName = passenger->getLastName();
+            line.firstName = passenger->getFirstName();
+            line.phone = passenger->getPhoneNumber();
+            sheet.manifest.append(line);
+        }
+        std::stable_sort(sheet.manifest.begin(), sheet.manifest.end(),
+                         [](const ManifestLine& a, const ManifestLine& b) { return a.order < b.order; });
+        return sheet;
+    }
+
+    QString fileStem(const QString& flightNumber) {
+        static const QRegularExpression unsafe("[^A-Za-z0-9_-]");
+        QString stem = flightNumber;
+        stem.replace(unsafe, "_");
+        return stem.isEmpty() ? QString("flight") : stem;
+    }
+
+    // Distinct numbers such as "AB/1" and "AB_1" sanitise to the same stem, and some
+    // file systems ignore case; later flights get a numeric suffix so no two jobs
+    // ever write the same file
+    void assignFileStems(std::vector<FlightSheet>& sheets) {
+        QSet<QString> taken;
+        for (FlightSheet& sheet : sheets) {
+            const QString base = fileStem(sheet.flightNumber);
+            QString stem = base;
+            for (int suffix = 2; taken.contains(stem.toLower()); ++suffix) {
+                stem = QString("%1-%2").arg(base).arg(suffix);
+            }
+            taken.insert(stem.toLower());
+            sheet.fileStem = stem;
+        }
+    }
+
+    // Returns the pages written, or -1 on failure
+    int renderSeatMap(const FlightSheet& sheet, const SeatMapGeometry& geometry, const QString& path) {
+        const QRect bounds = geometry.bounds();
+        const QSize sceneSize(bounds.width() + 2 * kSeatMapMargin,
+                              bounds.height() + 2 * kSeatMapMargin + kSeatMapHeader);
+        QImage image(sceneSize * kSeatMapScale, QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(kSeatMapScale);
+        image.fill(Qt::white);
+
+        QPainter painter(&image);
+        painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+        painter.setPen(QColor("#2c3e50"));
+        painter.setFont(QFont("Segoe UI", 14, QFont::Bold));
+        painter.drawText(QRect(kSeatMapMargin, kSeatMapMargin, bounds.width(), kSeatMapHeader),
+                         Qt::AlignLeft | Qt::AlignTop, sheet.title);
+
+        const QMap<QString, QColor> colors = SeatMapWidget::defaultClassColors();
+        const QFont labelFont = SeatMapWidget::seatLabelFont();
+        painter.translate(kSeatMapMargin - bounds.left(), kSeatMapMargin + kSeatMapHeader - bounds.top());
+        const auto& seats = geometry.seats();
+        for (int i = 0; i < seats.size(); ++i) {
+            const bool occupied = i < sheet.states.size() && sheet.states[i].occupied;
+            SeatMapWidget::drawSeatShape(&painter, seats[i], colors, labelFont, occupied, false, false);
+        }
+        painter.end();
+
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "PNG") || !file.commit()) {
+            qWarning() << "Failed to write seat map" << path;
+            return -1;
+        }
+        return 1;
+    }
+
+    int renderManifest(const FlightSheet& sheet, const QString& path) {
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly)) {
+            qWarning() << "Failed to write manifest" << path;
+            return -1;
+        }
+
+        int pages = 1;
+        {
+            QPdfWriter writer(&file);
+            writer.setResolution(kManifestResolution);
+            writer.setPageSize(QPageSize(QPageSize::A4));
+            writer.setPageMargins(QMarginsF(15, 15, 15, 15), QPageLayout::Millimeter);
+            writer.setTitle(QString("Passenger Manifest %1").arg(sheet.flightNumber));
+
+            QPainter painter(&writer);
+            const QRect page = writer.pageLayout().paintRectPixels(writer.resolution());
+            const int width = page.width();
+            const QFont titleFont("Segoe UI", 14, QFont::Bold);
+            const QFont headerFont("Segoe UI", 9, QFont::Bold);
+            const QFont bodyFont("Segoe UI", 9);
+            const int lineHeight = QFontMetrics(bodyFont, &writer).height() * 5 / 4;
+            const int titleHeight = QFontMetrics(titleFont, &writer).height() * 2;
+
+            // Seat, class, last name, first name, phone
+            const int columns[] = {0, width * 10 / 100, width * 25 / 100, width * 50 / 100, width * 75 / 100};
+            auto drawRow = [&](int y, const QStringList& cells) {
+                for (int c = 0; c < cells.size(); ++c) {
+                    const int right = c + 1 < cells.size() ? columns[c + 1] : width;
+                    painter.drawText(QRect(columns[c], y, right - columns[c], lineHeight),
+                                     Qt::AlignLeft | Qt::AlignVCenter, cells[c]);
+                }
+            };
+            auto drawPageHeader = [&]() {
+                painter.setFont(titleFont);
+                painter.drawText(QRect(0, 0, width, titleHeight), Qt::AlignLeft | Qt::AlignTop,
+                                 "Passenger Manifest - " + sheet.title);
+                painter.setFont(bodyFont);
+                painter.drawText(QRect(0, 0, width, titleHeight), Qt::AlignRight | Qt::AlignTop,
+                                 QString("Page %1").arg(pages));
+                painter.setFont(headerFont);
+                drawRow(titleHeight, {"Seat", "Class", "Last Name", "First Name", "Phone"});
+                painter.drawLine(0, titleHeight + lineHeight, width, titleHeight + lineHeight);
+                painter.setFont(bodyFont);
+                return titleHeight + lineHeight * 5 / 4;
+            };
+
+            int y = drawPageHeader();
+            if (sheet.manifest.isEmpty()) {
+                drawRow(y, {"No passengers"});
+            }
+            for (const ManifestLine& line : sheet.manifest) {
+                if (y + lineHeight > page.height()) {
+                    writer.newPage();
+                    ++pages;
+                    y = drawPageHeader();
+                }
+                drawRow(y, {line.seat, line.seatClass, line.lastName, line.firstName, line.phone});
+                y += lineHeight;
+            }
+        }  // The writer finishes the PDF when the painter and writer go away
+
+        if (!file.commit()) {
+            qWarning() << "Failed to write manifest" << path;
+            return -1;
+        }
+        return pages;
+    }
+}
+
+FlightPrintRenderer::Result FlightPrintRenderer::Job::result() const {
+    Result result;
+    const QList<int> pages = future.results();
+    result.ok = !future.isCanceled() && pages.size() == files && !pages.contains(-1);
+    result.flights = flights;
+    for (int count : pages) {
+        result.pages += qMax(0, count);
+    }
+    result.elapsedMs = timer.elapsed();
+    return result;
+}
+
+FlightPrintRenderer::Job FlightPrintRenderer::start(const QString& directory,
+                                                    const std::vector<std::unique_ptr<Flight>>& flights) {
+    Job job;
+    job.timer.start();
+
+    auto state = std::make_shared<RenderState>();
+    state->dir = QDir(directory);
+    state->geometry = SeatMapGeometry::forAircraft(Flight::aircraftType());
+    if (!state->geometry || !state->dir.mkpath(".")) {
+        QPromise<int> failed;
+        failed.start();
+        failed.addResult(-1);
+        failed.finish();
+        job.future = failed.future();
+        return job;
+    }
+
+    state->sheets.reserve(flights.size());
+    for (const auto& flight : flights) {
+        state->sheets.push_back(makeSheet(*flight, *state->geometry));
+    }
+    assignFileStems(state->sheets);
+    state->jobs.reserve(state->sheets.size() * 2);
+    for (const FlightSheet& sheet : state->sheets) {
+        state->jobs.push_back({&sheet, false});
+        state->jobs.push_back({&sheet, true});
+    }
+    job.flights = static_cast<int>(state->sheets.size());
+    job.files = static_cast<int>(state->jobs.size());
+
+    // The functor holds the state, so it outlives the mapping whatever the caller does
+    auto render = [state](const RenderJob& renderJob) {
+        const QString stem = state->dir.filePath(renderJob.sheet->fileStem);
+        return renderJob.manifest ? renderManifest(*renderJob.sheet, stem + "-manifest.pdf")
+                                  : renderSeatMap(*renderJob.sheet, *state->geometry, stem + "-seatmap.png");
+    };
+
+    if (!QFontDatabase::supportsThreadedFontRendering()) {
+        // Text may only be drawn on the GUI thread here
+        QPromise<int> promise;
+        promise.start();
+        promise.setProgressRange(0, job.files);
+        for (const RenderJob& renderJob : state->jobs) {
+            promise.addResult(render(renderJob));
+            promise.setProgressValue(promise.future().resultCount());
+        }
+        promise.finish();
+        job.future = promise.future();
+        return job;
+    }
+
+    job.future = QtConcurrent::mapped(state->jobs.cbegin(), state->jobs.cend(), render);
+    return job;
+}
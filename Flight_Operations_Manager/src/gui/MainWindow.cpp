@@ -7,27 +7,59 @@
 #include "ui_mainwindow.h"
 #include "gui/FlightDialog.h"
 #include "gui/PassengerDialog.h"
+#include "gui/PassengerTableModel.h"
+#include "gui/FlightListModel.h"
+#include "gui/PassengerSearchModel.h"
+#include "gui/FlightPrintRenderer.h"
 #include "database/Database.h"
+#include "database/OperationLog.h"
+#include "database/AutosaveScheduler.h"
+#include "database/CsvImporter.h"
+#include "database/CompressedSnapshot.h"
+#include "database/ColumnarExporter.h"
+#include "database/SnapshotView.h"
+#include "models/FlightQuery.h"
+#include <QApplication>
 #include <QMessageBox>
 #include <QDateTime>
 #include <QFileDialog>
 #include <QTextEdit>
 #include <QPushButton>
 #include <QVBoxLayout>
-#include <QInputDialog>
+#include <QLineEdit>
+#include <QTableView>
+#include <QLabel>
 #include <QHeaderView>
 #include <QDebug>
 #include <QShortcut>
 #include <QAction>
 #include <QGraphicsOpacityEffect>
 #include <QPropertyAnimation>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QCloseEvent>
+#include <QStandardPaths>
+#include <QSettings>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QProgressDialog>
+
+namespace {
+    // Fold the delta journal into a new base once it grows past this size
+    constexpr qint64 kJournalCompactionThreshold = 4 * 1024 * 1024;
+}
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , airline(std::make_unique<Airline>("Sample Airline"))
+    , operationLog(new OperationLog(this))
+    , autosave(new AutosaveScheduler(*airline, operationLog, this))
 {
     ui->setupUi(this);
+    setupRecovery();
+    setupAutosave();
     setupUI();
     
     // A professional, dark theme with blue and gold accents
@@ -55,7 +87,7 @@ MainWindow::MainWindow(QWidget *parent)
             background-color: #34495e;
             border: none;
         }
-        QListView, QTableWidget {
+        QListView, QTableView {
             background-color: #34495e;
             color: #ecf0f1;
             border: 1px solid #2c3e50;
@@ -69,10 +101,10 @@ MainWindow::MainWindow(QWidget *parent)
             border: none;
             font-weight: bold;
         }
-        QListView::item:hover, QTableWidget::item:hover {
+        QListView::item:hover, QTableView::item:hover {
             background-color: #4a627a;
         }
-        QListView::item:selected, QTableWidget::item:selected {
+        QListView::item:selected, QTableView::item:selected {
             background-color: #f39c12;
             color: #2c3e50;
         }
@@ -116,26 +148,144 @@ MainWindow::MainWindow(QWidget *parent)
     if (auto* action = ui->actionEditFlight) action->setToolTip(tr("Edit the selected flight's details."));
     if (auto* action = ui->actionDeleteFlight) action->setToolTip(tr("Delete the selected flight and all its passengers."));
     if (auto* action = ui->actionSaveData) action->setToolTip(tr("Save all flight and passenger data to a file."));
+    if (auto* action = ui->actionSaveChanges) action->setToolTip(tr("Append only the flights changed since the last save to the current file."));
     if (auto* action = ui->actionLoadData) action->setToolTip(tr("Load flight and passenger data from a file."));
     if (auto* action = ui->actionExportData) action->setToolTip(tr("Export all data to a CSV file."));
+    if (auto* action = ui->actionExportColumnar) action->setToolTip(tr("Export typed column files for analytics tools."));
+    if (auto* action = ui->actionImportManifest) action->setToolTip(tr("Import passengers from a CSV manifest."));
     if (auto* action = ui->actionFlightReport) action->setToolTip(tr("Generate a report for the selected flight."));
     if (auto* action = ui->actionPassengerReport) action->setToolTip(tr("Generate a passenger report for the selected flight."));
     if (auto* action = ui->actionRevenueReport) action->setToolTip(tr("Generate a revenue report for all flights."));
+    if (auto* action = ui->actionSnapshotRevenueReport) action->setToolTip(tr("Generate a revenue report from a saved report snapshot."));
+    if (auto* action = ui->actionExportReportSnapshot) action->setToolTip(tr("Write a read-only snapshot for fast reporting."));
+    if (auto* action = ui->actionRenderFlightSheets) action->setToolTip(tr("Render seat map images and PDF manifests for every flight."));
 }
 
 MainWindow::~MainWindow() {
+    autosave->stop();
+    autosave->waitForIdle();
+    airline->setOperationLog(nullptr);
     delete ui;
 }
 
+void MainWindow::closeEvent(QCloseEvent* event) {
+    // A clean exit folds the log into the recovery snapshot
+    autosave->stop();
+    checkpointRecovery();
+    QMainWindow::closeEvent(event);
+}
+
+QString MainWindow::recoveryPath(const QString& fileName) const {
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(dir);
+    return QDir(dir).filePath(fileName);
+}
+
+void MainWindow::setupRecovery() {
+    // Restore the last checkpoint, then replay bookings logged after it
+    std::vector<std::unique_ptr<Flight>> flights;
+    QString baseFile = QSettings().value("recovery/baseFile").toString();
+    if (Database::loadData(recoveryPath("recovery.json"), flights)) {
+        airline->setFlights(std::move(flights));
+    } else if (!baseFile.isEmpty() && loadDataFile(baseFile)) {
+        currentDataFile = baseFile;
+    }
+    // Records archived for an autosave that never landed come before the live log
+    int replayed = OperationLog::replay(recoveryPath("recovery.wal.archive"), *airline);
+    replayed += OperationLog::replay(recoveryPath("recovery.wal"), *airline);
+
+    QSettings settings;
+    QString policy = settings.value("recovery/syncPolicy", "batched").toString();
+    int batchSize = settings.value("recovery/syncBatchSize", 64).toInt();
+    int intervalMs = settings.value("recovery/syncIntervalMs", 200).toInt();
+    if (policy == "perOperation") {
+        operationLog->setSyncPolicy(OperationLog::SyncPolicy::PerOperation);
+    } else if (policy == "timed") {
+        operationLog->setSyncPolicy(OperationLog::SyncPolicy::Timed, batchSize, intervalMs);
+    } else {
+        operationLog->setSyncPolicy(OperationLog::SyncPolicy::Batched, batchSize, intervalMs);
+    }
+
+    connect(operationLog, &OperationLog::writeFailed, this, [this]() {
+        airline->setOperationLog(nullptr);
+        QMessageBox::warning(this, tr("Warning"),
+            tr("The recovery log could not be written. Changes from now on will not survive a crash; save your data."));
+    });
+    if (operationLog->open(recoveryPath("recovery.wal"))) {
+        airline->setOperationLog(operationLog);
+    } else {
+        qWarning() << "Could not open the recovery log; bookings will not survive a crash";
+    }
+    if (replayed > 0) {
+        statusBar()->showMessage(tr("Recovered %1 booking operation(s) from the last session.").arg(replayed), 5000);
+    }
+}
+
+void MainWindow::setupAutosave() {
+    QSettings settings;
+    autosave->setTarget(recoveryPath("recovery.json"), recoveryPath("recovery.wal.archive"));
+    autosave->setDelays(settings.value("autosave/quietMs", 2000).toInt(),
+                        settings.value("autosave/maxDelayMs", 30000).toInt());
+    connect(autosave, &AutosaveScheduler::saved, this, [this](qint64, qint64, int changes) {
+        statusBar()->showMessage(tr("Autosaved %1 change(s).").arg(changes), 2000);
+    });
+    connect(autosave, &AutosaveScheduler::saveFailed, this, [](const QString& path) {
+        qWarning() << "Autosave failed to write" << path;
+    });
+    connect(autosave, &AutosaveScheduler::suspendedChanged, this, [this](bool suspended) {
+        statusBar()->showMessage(suspended
+            ? tr("Autosave paused until every flight is loaded; the recovery log still records changes.")
+            : tr("Autosave resumed."), 5000);
+    });
+    if (settings.value("autosave/enabled", true).toBool()) {
+        autosave->start();
+    }
+}
+
+void MainWindow::checkpointRecovery() {
+    if (!operationLog->isOpen()) return;
+    // The snapshot below must not race a background autosave of the same file
+    autosave->waitForIdle();
+
+    QSettings settings;
+    if (airline->hasUnloadedFlights() && !airline->hasUnsavedChanges()) {
+        // The airline still matches the lazily loaded file; point recovery at it
+        // instead of materializing every flight to write a copy
+        settings.setValue("recovery/baseFile", currentDataFile);
+        QFile::remove(recoveryPath("recovery.json"));
+        QFile::remove(recoveryPath("recovery.wal.archive"));
+        operationLog->reset();
+        return;
+    }
+    // A partial load would write header-only flights over the recovery base
+    if (!airline->ensureAllLoaded()) return;
+    if (Database::saveData(recoveryPath("recovery.json"), airline->getFlights())) {
+        settings.remove("recovery/baseFile");
+        QFile::remove(recoveryPath("recovery.wal.archive"));
+        operationLog->reset();
+    }
+}
+
 void MainWindow::setupUI() {
     // Set up flight list
+    flightModel = new FlightListModel(*airline, this);
+    ui->flightList->setModel(flightModel);
     ui->flightList->setSelectionMode(QAbstractItemView::SingleSelection);
+    // Every row has the same height, so the view never measures rows it does not show
+    ui->flightList->setUniformItemSizes(true);
     
     // Set up passenger table
+    passengerModel = new PassengerTableModel(*airline, this);
+    ui->passengerTable->setModel(passengerModel);
+    ui->passengerTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     ui->passengerTable->setSelectionMode(QAbstractItemView::SingleSelection);
     ui->passengerTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
     ui->passengerTable->horizontalHeader()->setStretchLastSection(true);
     ui->passengerTable->verticalHeader()->setVisible(false);
+    // Fixed row heights keep scrolling independent of the row count
+    ui->passengerTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    connect(ui->flightList->selectionModel(), &QItemSelectionModel::currentRowChanged,
+            this, &MainWindow::updatePassengerTable);
     
     // Set up seat map
     // TODO: Initialize seat map widget
@@ -145,38 +295,30 @@ void MainWindow::setupUI() {
 }
 
 void MainWindow::updateFlightList() {
-    ui->flightList->clear();
-    
-    for (const auto& flight : airline->getFlights()) {
-        QString displayText = QString("%1 - %2 to %3 (%4)")
-            .arg(flight->getFlightNumber())
-            .arg(flight->getOrigin())
-            .arg(flight->getDestination())
-            .arg(flight->getDepartureTime().toString("yyyy-MM-dd hh:mm"));
-        ui->flightList->addItem(displayText);
-    }
+    // Rows are kept current from the change feed; this applies pending changes now
+    flightModel->sync();
 }
 
 void MainWindow::updatePassengerTable() {
-    ui->passengerTable->clearContents();
-    ui->passengerTable->setRowCount(0);
-    
-    QListWidgetItem* item = ui->flightList->currentItem();
-    if (!item) return;
-    
-    QString flightNumber = item->text().split(" - ").first();
-    Flight* flight = airline->getFlight(flightNumber);
-    if (!flight) return;
-    
-    auto passengers = flight->getPassengers();
-    ui->passengerTable->setRowCount(passengers.size());
-    
-    for (size_t i = 0; i < passengers.size(); ++i) {
-        Passenger* passenger = passengers[i];
-        ui->passengerTable->setItem(i, 0, new QTableWidgetItem(passenger->getFirstName()));
-        ui->passengerTable->setItem(i, 1, new QTableWidgetItem(passenger->getLastName()));
-        ui->passengerTable->setItem(i, 2, new QTableWidgetItem(passenger->getPhoneNumber()));
-        ui->passengerTable->setItem(i, 3, new QTableWidgetItem(passenger->getSeatNumber()));
+    // The model picks up mutations from the change feed; this applies them now,
+    // before the view can paint rows for passengers that no longer exist
+    if (passengerModel->isAirlineWide()) {
+        if (airline->hasUnloadedFlights()) {
+            // Flights that fail to load were reported when the view was switched on;
+            // the list shows the rest
+            airline->ensureAllLoaded();
+            passengerModel->showAllFlights();
+        } else {
+            passengerModel->sync();
+        }
+        return;
+    }
+
+    Flight* flight = getCurrentFlight();
+    if (flight == passengerModel->flight()) {
+        passengerModel->sync();
+    } else {
+        passengerModel->setFlight(flight);
     }
 }
 
@@ -184,22 +326,20 @@ void MainWindow::updateSeatMap() {
     // TODO: Update seat map visualization
 }
 
+QString MainWindow::currentFlightNumber() const {
+    const QModelIndex current = ui->flightList->currentIndex();
+    return current.isValid() ? flightModel->flightNumberAt(current.row()) : QString();
+}
+
 Flight* MainWindow::getCurrentFlight() const {
-    int currentRow = ui->flightList->currentRow();
-    if (currentRow >= 0 && currentRow < static_cast<int>(airline->getFlights().size())) {
-        return airline->getFlights()[currentRow].get();
-    }
-    return nullptr;
+    // Looked up by number so a lazily loaded flight is materialized first
+    const QString flightNumber = currentFlightNumber();
+    return flightNumber.isEmpty() ? nullptr : airline->getFlight(flightNumber);
 }
 
 Passenger* MainWindow::getCurrentPassenger() const {
-    int currentRow = ui->passengerTable->currentRow();
-    auto currentFlight = getCurrentFlight();
-    if (currentFlight && currentRow >= 0 && 
-        currentRow < static_cast<int>(currentFlight->getPassengers().size())) {
-        return currentFlight->getPassengers()[currentRow];
-    }
-    return nullptr;
+    const QModelIndex current = ui->passengerTable->currentIndex();
+    return current.isValid() ? passengerModel->passengerAt(current.row()) : nullptr;
 }
 
 void MainWindow::on_actionNewFlight_triggered() {
@@ -220,12 +360,11 @@ void MainWindow::on_actionNewFlight_triggered() {
 }
 
 void MainWindow::on_actionEditFlight_triggered() {
-    QListWidgetItem* item = ui->flightList->currentItem();
-    if (!item) {
+    QString flightNumber = currentFlightNumber();
+    if (flightNumber.isEmpty()) {
         QMessageBox::warning(this, tr("No Selection"), tr("Please select a flight to edit."));
         return;
     }
-    QString flightNumber = item->text().split(" - ").first();
     Flight* flight = airline->getFlight(flightNumber);
     if (!flight) {
         QMessageBox::critical(this, tr("Error"), tr("Selected flight not found."));
@@ -254,12 +393,11 @@ void MainWindow::on_actionEditFlight_triggered() {
 }
 
 void MainWindow::on_actionDeleteFlight_triggered() {
-    QListWidgetItem* item = ui->flightList->currentItem();
-    if (!item) {
+    QString flightNumber = currentFlightNumber();
+    if (flightNumber.isEmpty()) {
         QMessageBox::warning(this, tr("No Selection"), tr("Please select a flight to delete."));
         return;
     }
-    QString flightNumber = item->text().split(" - ").first();
     Flight* flight = airline->getFlight(flightNumber);
     if (!flight) {
         QMessageBox::critical(this, tr("Error"), tr("Selected flight not found."));
@@ -304,12 +442,11 @@ void MainWindow::on_actionDeleteFlight_triggered() {
 }
 
 void MainWindow::on_actionAddPassenger_triggered() {
-    QListWidgetItem* item = ui->flightList->currentItem();
-    if (!item) {
+    QString flightNumber = currentFlightNumber();
+    if (flightNumber.isEmpty()) {
         QMessageBox::warning(this, tr("No Selection"), tr("Please select a flight to add a passenger to."));
         return;
     }
-    QString flightNumber = item->text().split(" - ").first();
     Flight* flight = airline->getFlight(flightNumber);
     if (!flight) {
         QMessageBox::critical(this, tr("Error"), tr("Selected flight not found."));
@@ -320,7 +457,7 @@ void MainWindow::on_actionAddPassenger_triggered() {
     if (dialog.exec() == QDialog::Accepted) {
         std::unique_ptr<Passenger> passenger(dialog.getPassenger());
         if (passenger) {
-            flight->addPassenger(std::move(passenger));
+            airline->addPassenger(std::move(passenger), flightNumber);
             updatePassengerTable();
             ui->passengerTable->clearSelection();
         }
@@ -328,23 +465,19 @@ void MainWindow::on_actionAddPassenger_triggered() {
 }
 
 void MainWindow::on_actionEditPassenger_triggered() {
-    QTableWidgetItem* item = ui->passengerTable->currentItem();
-    if (!item) {
+    const QModelIndex current = ui->passengerTable->currentIndex();
+    if (!current.isValid()) {
         QMessageBox::warning(this, tr("No Selection"), tr("Please select a passenger to edit."));
         return;
     }
-    QListWidgetItem* flightItem = ui->flightList->currentItem();
-    if (!flightItem) {
-        QMessageBox::critical(this, tr("Error"), tr("No flight selected."));
-        return;
-    }
-    QString flightNumber = flightItem->text().split(" - ").first();
+    // The row carries its own flight, which differs from the list selection in the airline-wide view
+    QString flightNumber = passengerModel->flightNumberAt(current.row());
     Flight* flight = airline->getFlight(flightNumber);
     if (!flight) {
         QMessageBox::critical(this, tr("Error"), tr("Selected flight not found."));
         return;
     }
-    QString seatNumber = ui->passengerTable->item(item->row(), 3)->text();
+    QString seatNumber = passengerModel->passengerIdAt(current.row());
     Passenger* passenger = flight->getPassenger(seatNumber);
     if (!passenger) {
         QMessageBox::critical(this, tr("Error"), tr("Selected passenger not found."));
@@ -356,8 +489,10 @@ void MainWindow::on_actionEditPassenger_triggered() {
     if (dialog.exec() == QDialog::Accepted) {
         std::unique_ptr<Passenger> newPassenger(dialog.getPassenger());
         if (newPassenger) {
-            flight->removePassenger(seatNumber);
-            flight->addPassenger(std::move(newPassenger));
+            if (!airline->updatePassenger(seatNumber, std::move(newPassenger), flightNumber)) {
+                QMessageBox::warning(this, tr("Edit Passenger"),
+                                     tr("The passenger could not be moved to the selected seat."));
+            }
             updatePassengerTable();
             ui->passengerTable->clearSelection();
         }
@@ -365,23 +500,19 @@ void MainWindow::on_actionEditPassenger_triggered() {
 }
 
 void MainWindow::on_actionRemovePassenger_triggered() {
-    QTableWidgetItem* item = ui->passengerTable->currentItem();
-    if (!item) {
+    const QModelIndex current = ui->passengerTable->currentIndex();
+    if (!current.isValid()) {
         QMessageBox::warning(this, tr("No Selection"), tr("Please select a passenger to remove."));
         return;
     }
-    QListWidgetItem* flightItem = ui->flightList->currentItem();
-    if (!flightItem) {
-        QMessageBox::critical(this, tr("Error"), tr("No flight selected."));
-        return;
-    }
-    QString flightNumber = flightItem->text().split(" - ").first();
+    // The row carries its own flight, which differs from the list selection in the airline-wide view
+    QString flightNumber = passengerModel->flightNumberAt(current.row());
     Flight* flight = airline->getFlight(flightNumber);
     if (!flight) {
         QMessageBox::critical(this, tr("Error"), tr("Selected flight not found."));
         return;
     }
-    QString seatNumber = ui->passengerTable->item(item->row(), 3)->text();
+    QString seatNumber = passengerModel->passengerIdAt(current.row());
     Passenger* passenger = flight->getPassenger(seatNumber);
     if (!passenger) {
         QMessageBox::critical(this, tr("Error"), tr("Selected passenger not found."));
@@ -413,26 +544,86 @@ void MainWindow::on_actionRemovePassenger_triggered() {
     anim->setEasingCurve(QEasingCurve::InOutQuad);
     anim->start(QAbstractAnimation::DeleteWhenStopped);
     if (confirmDialog.exec() == QDialog::Accepted) {
-        flight->removePassenger(seatNumber);
+        airline->removePassenger(seatNumber, flightNumber);
         updatePassengerTable();
         ui->passengerTable->clearSelection();
     }
 }
 
-void MainWindow::on_actionSearchPassenger_triggered() {
-    bool ok = false;
-    QString query = QInputDialog::getText(this, tr("Search Passenger"), tr("Enter name or phone number:"), QLineEdit::Normal, QString(), &ok);
-    if (!ok || query.trimmed().isEmpty()) return;
-    auto results = airline->searchPassengers(query.trimmed());
-    if (results.empty()) {
-        QMessageBox::information(this, tr("No Results"), tr("No passengers found matching '%1'.").arg(query));
+void MainWindow::on_actionShowAllPassengers_toggled(bool checked) {
+    if (!checked) {
+        passengerModel->setFlight(nullptr);
+        updatePassengerTable();
         return;
     }
-    QString msg = tr("Found %1 passenger(s):\n\n").arg(results.size());
-    for (const auto* p : results) {
-        msg += QString("%1 %2, Phone: %3, Seat: %4\n").arg(p->getFirstName()).arg(p->getLastName()).arg(p->getPhoneNumber()).arg(p->getSeatNumber());
+    if (!airline->ensureAllLoaded()) {
+        QMessageBox::warning(this, tr("Warning"), tr("Some flights could not be loaded; their passengers are not listed."));
+    }
+    passengerModel->showAllFlights();
+}
+
+void MainWindow::on_actionSearchPassenger_triggered() {
+    // Flights still on disk would be missing from the search snapshot
+    if (!airline->ensureAllLoaded()) {
+        QMessageBox::warning(this, tr("Warning"), tr("Some flights could not be loaded; their passengers are not searched."));
+    }
+    if (!searchDialog) {
+        createSearchDialog();
     }
-    QMessageBox::information(this, tr("Search Results"), msg);
+    searchDialog->show();
+    searchDialog->raise();
+    searchDialog->activateWindow();
+}
+
+void MainWindow::createSearchDialog() {
+    searchDialog = new QDialog(this);
+    searchDialog->setWindowTitle(tr("Search Passenger"));
+    searchDialog->resize(720, 480);
+    QVBoxLayout* layout = new QVBoxLayout(searchDialog);
+
+    QLineEdit* queryEdit = new QLineEdit(searchDialog);
+    queryEdit->setPlaceholderText(tr("Enter name or phone number"));
+    queryEdit->setClearButtonEnabled(true);
+    layout->addWidget(queryEdit);
+
+    searchModel = new PassengerSearchModel(*airline, searchDialog);
+    QTableView* results = new QTableView(searchDialog);
+    results->setModel(searchModel);
+    results->setSelectionBehavior(QAbstractItemView::SelectRows);
+    results->setSelectionMode(QAbstractItemView::SingleSelection);
+    results->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    results->horizontalHeader()->setStretchLastSection(true);
+    results->verticalHeader()->setVisible(false);
+    results->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    layout->addWidget(results);
+
+    QLabel* status = new QLabel(searchDialog);
+    layout->addWidget(status);
+
+    connect(queryEdit, &QLineEdit::textChanged, searchModel, &PassengerSearchModel::setQuery);
+    connect(searchModel, &PassengerSearchModel::searchFinished, status,
+            [this, status](int matches, qint64 firstResultMs, qint64 totalMs) {
+        if (matches == 0) {
+            status->setText(tr("No passengers found (%1 ms).").arg(totalMs));
+        } else {
+            status->setText(tr("Found %1 passenger(s); first result after %2 ms, done after %3 ms.")
+                                .arg(matches).arg(firstResultMs).arg(totalMs));
+        }
+    });
+
+    // Double-clicking a result selects its flight and passenger in the main window
+    connect(results, &QTableView::doubleClicked, this, [this](const QModelIndex& index) {
+        const QString flightNumber = searchModel->flightNumberAt(index.row());
+        const int flightRow = flightModel->rowOf(flightNumber);
+        if (flightRow < 0) return;
+        ui->flightList->setCurrentIndex(flightModel->index(flightRow));
+        updatePassengerTable();
+        const int passengerRow = passengerModel->rowOf(flightNumber, searchModel->passengerIdAt(index.row()));
+        if (passengerRow >= 0) {
+            ui->passengerTable->selectRow(passengerRow);
+            ui->passengerTable->scrollTo(passengerModel->index(passengerRow, 0));
+        }
+    });
 }
 
 void MainWindow::on_actionBookTicket_triggered() {
@@ -501,24 +692,67 @@ void MainWindow::on_actionPassengerReport_triggered() {
 }
 
 void MainWindow::on_actionRevenueReport_triggered() {
+    if (!airline->ensureAllLoaded()) {
+        QMessageBox::critical(this, tr("Error"), tr("Failed to load all flights for the revenue report."));
+        return;
+    }
+    generateReport("Revenue Report", revenueReport(AirlineQuery(*airline)));
+}
+
+void MainWindow::on_actionSnapshotRevenueReport_triggered() {
+    QString filename = QFileDialog::getOpenFileName(this,
+        tr("Open Report Snapshot"), "",
+        tr("Report Snapshots (*.fomb);;All Files (*)"));
+
+    if (filename.isEmpty()) return;
+
+    // Answered straight from the mapped file; no flights are loaded
+    SnapshotView snapshot;
+    if (!snapshot.open(filename)) {
+        QMessageBox::critical(this, tr("Error"), tr("Failed to open report snapshot."));
+        return;
+    }
+    generateReport("Revenue Report", revenueReport(snapshot));
+}
+
+void MainWindow::on_actionExportReportSnapshot_triggered() {
+    QString filename = QFileDialog::getSaveFileName(this,
+        tr("Export Report Snapshot"), "",
+        tr("Report Snapshots (*.fomb);;All Files (*)"));
+
+    if (filename.isEmpty()) return;
+
+    if (!filename.endsWith(".fomb")) {
+        filename += ".fomb";
+    }
+
+    if (!airline->ensureAllLoaded()) {
+        QMessageBox::critical(this, tr("Error"), tr("Failed to load all flights for export."));
+        return;
+    }
+    if (SnapshotView::write(filename, airline->getFlights())) {
+        QMessageBox::information(this, tr("Success"), tr("Report snapshot exported successfully."));
+    } else {
+        QMessageBox::critical(this, tr("Error"), tr("Failed to export report snapshot."));
+    }
+}
+
+QString MainWindow::revenueReport(const FlightQuery& source) const {
     double totalRevenue = 0.0;
     int totalPassengers = 0;
     
     QString report = "Revenue Report\n\n";
     
-    for (const auto& flight : airline->getFlights()) {
-        double flightRevenue = flight->calculateRevenue();
-        int passengerCount = flight->getAllPassengers().size();
-        
+    for (const FlightSummary& flight : source.allFlights()) {
         report += QString("Flight %1:\n"
                         "Passengers: %2\n"
                         "Revenue: $%3\n\n")
-                     .arg(flight->getFlightNumber())
-                     .arg(passengerCount)
-                     .arg(flightRevenue, 0, 'f', 2);
+                     .arg(flight.flightNumber)
+                     .arg(flight.passengerCount)
+                     .arg(flight.revenue, 0, 'f', 2);
         
-        totalRevenue += flightRevenue;
-        totalPassengers += passengerCount;
+        totalRevenue += flight.revenue;
+        totalPassengers += flight.passengerCount;
     }
     
     report += QString("\nTotal Passengers: %1\n"
@@ -527,38 +761,131 @@ void MainWindow::on_actionRevenueReport_triggered() {
                  .arg(totalPassengers)
                  .arg(totalRevenue, 0, 'f', 2)
                  .arg(totalPassengers > 0 ? totalRevenue / totalPassengers : 0.0, 0, 'f', 2);
-    
-    generateReport("Revenue Report", report);
+    return report;
 }
 
 void MainWindow::on_actionSaveData_triggered() {
     QString filename = QFileDialog::getSaveFileName(this,
         tr("Save Flight Data"), "",
-        tr("Flight Data (*.json);;All Files (*)"));
+        tr("Flight Data (*.json);;Compressed Flight Data (*.fomz);;All Files (*)"));
     
     if (filename.isEmpty()) return;
     
-    if (!filename.endsWith(".json")) {
+    if (!filename.endsWith(".json") && !filename.endsWith(".fomz")) {
         filename += ".json";
     }
     
-    if (Database::saveData(filename, airline->getFlights())) {
+    if (saveDataFile(filename)) {
+        airline->markClean();
+        currentDataFile = filename;
+        checkpointRecovery();
         QMessageBox::information(this, tr("Success"), tr("Data saved successfully."));
     } else {
         QMessageBox::critical(this, tr("Error"), tr("Failed to save data."));
     }
 }
 
+bool MainWindow::saveDataFile(const QString& filename) {
+    if (!airline->ensureAllLoaded()) {
+        return false;
+    }
+    if (filename.endsWith(".fomz")) {
+        return CompressedSnapshot::save(filename, airline->getFlights());
+    }
+    return Database::saveData(filename, airline->getFlights());
+}
+
+bool MainWindow::loadDataFile(const QString& filename) {
+    // Detected by content so renamed files still load
+    if (CompressedSnapshot::isCompressedFile(filename)) {
+        // Only the index is read now; flights are inflated when first used
+        auto snapshot = std::make_shared<CompressedSnapshot>();
+        if (!snapshot->open(filename)) {
+            return false;
+        }
+        int maxResident = QSettings().value("loading/maxResidentFlights", 64).toInt();
+        airline->setFlights(snapshot->loadHeaders());
+        airline->setFlightLoader([snapshot](const QString& flightNumber) {
+            return snapshot->loadFlight(flightNumber);
+        }, static_cast<size_t>(qMax(1, maxResident)),
+        [snapshot](std::vector<std::unique_ptr<Flight>>& flights) {
+            // Full materializations inflate every block in parallel
+            return snapshot->loadAll(flights);
+        });
+        refreshSearch();
+        return true;
+    }
+
+    std::vector<std::unique_ptr<Flight>> flights;
+    if (!Database::loadData(filename, flights)) {
+        return false;
+    }
+    airline->setFlights(std::move(flights));
+    refreshSearch();
+    return true;
+}
+
+void MainWindow::refreshSearch() {
+    // An open search must keep covering every flight, including ones a lazy load left on disk
+    if (!searchDialog || !searchDialog->isVisible()) return;
+    if (!airline->ensureAllLoaded()) {
+        QMessageBox::warning(this, tr("Warning"), tr("Some flights could not be loaded; their passengers are not searched."));
+    }
+    searchModel->refresh();
+}
+
+void MainWindow::on_actionSaveChanges_triggered() {
+    if (currentDataFile.isEmpty()) {
+        // Nothing to append to yet, write a full snapshot first
+        on_actionSaveData_triggered();
+        return;
+    }
+    if (CompressedSnapshot::isCompressedFile(currentDataFile)) {
+        // Compressed files carry no delta journal; rewrite them whole
+        if (saveDataFile(currentDataFile)) {
+            airline->markClean();
+            checkpointRecovery();
+            statusBar()->showMessage(tr("Saved %1.").arg(QFileInfo(currentDataFile).fileName()), 3000);
+        } else {
+            QMessageBox::critical(this, tr("Error"), tr("Failed to save changes."));
+        }
+        return;
+    }
+    if (!airline->hasUnsavedChanges()) {
+        statusBar()->showMessage(tr("No changes to save."), 3000);
+        return;
+    }
+
+    auto changedFlights = airline->getDirtyFlights();
+    QStringList removedFlights = airline->getRemovedFlights();
+    if (Database::saveDelta(currentDataFile, changedFlights, removedFlights)) {
+        airline->markClean();
+        statusBar()->showMessage(tr("Saved %1 changed and %2 removed flight(s).")
+                                     .arg(changedFlights.size())
+                                     .arg(removedFlights.size()), 3000);
+        compactJournalIfNeeded();
+    } else {
+        QMessageBox::critical(this, tr("Error"), tr("Failed to save changes."));
+    }
+}
+
+void MainWindow::compactJournalIfNeeded() {
+    if (compactionFuture.isRunning()) return;
+    if (Database::journalSize(currentDataFile) < kJournalCompactionThreshold) return;
+    compactionFuture = QtConcurrent::run(&Database::compactJournal, currentDataFile);
+}
+
 void MainWindow::on_actionLoadData_triggered() {
     QString filename = QFileDialog::getOpenFileName(this,
         tr("Load Flight Data"), "",
-        tr("Flight Data (*.json);;All Files (*)"));
+        tr("Flight Data (*.json *.fomz);;All Files (*)"));
     
     if (filename.isEmpty()) return;
     
-    std::vector<std::unique_ptr<Flight>> flights;
-    if (Database::loadData(filename, flights)) {
-        airline->setFlights(std::move(flights));
+    if (loadDataFile(filename)) {
+        airline->markClean();
+        currentDataFile = filename;
+        checkpointRecovery();
         updateFlightList();
         updatePassengerTable();
         QMessageBox::information(this, tr("Success"), tr("Data loaded successfully."));
@@ -578,6 +905,10 @@ void MainWindow::on_actionExportData_triggered() {
         filename += ".csv";
     }
     
+    if (!airline->ensureAllLoaded()) {
+        QMessageBox::critical(this, tr("Error"), tr("Failed to load all flights for export."));
+        return;
+    }
     if (Database::exportToCSV(filename, airline->getFlights())) {
         QMessageBox::information(this, tr("Success"), tr("Data exported successfully."));
     } else {
@@ -585,6 +916,122 @@ void MainWindow::on_actionExportData_triggered() {
     }
 }
 
+void MainWindow::on_actionExportColumnar_triggered() {
+    QString directory = QFileDialog::getExistingDirectory(this, tr("Export Columnar Data"));
+
+    if (directory.isEmpty()) return;
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    if (!airline->ensureAllLoaded()) {
+        QApplication::restoreOverrideCursor();
+        QMessageBox::critical(this, tr("Error"), tr("Failed to load all flights for export."));
+        return;
+    }
+    bool exported = ColumnarExporter::exportTo(directory, airline->getFlights());
+    QApplication::restoreOverrideCursor();
+
+    if (exported) {
+        QMessageBox::information(this, tr("Success"), tr("Columnar data exported successfully."));
+    } else {
+        QMessageBox::critical(this, tr("Error"), tr("Failed to export columnar data."));
+    }
+}
+
+void MainWindow::on_actionRenderFlightSheets_triggered() {
+    QString directory = QFileDialog::getExistingDirectory(this, tr("Render Seat Maps and Manifests"));
+
+    if (directory.isEmpty()) return;
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    if (!airline->ensureAllLoaded()) {
+        QApplication::restoreOverrideCursor();
+        QMessageBox::critical(this, tr("Error"), tr("Failed to load all flights for rendering."));
+        return;
+    }
+    const FlightPrintRenderer::Job job = FlightPrintRenderer::start(directory, airline->getFlights());
+    QApplication::restoreOverrideCursor();
+
+    // The flights were copied when the job started; the window stays usable meanwhile
+    auto* progress = new QProgressDialog(tr("Rendering seat maps and manifests..."), tr("Cancel"),
+                                         0, qMax(1, job.files), this);
+    progress->setAttribute(Qt::WA_DeleteOnClose);
+    progress->setMinimumDuration(500);
+    auto* watcher = new QFutureWatcher<int>(this);
+    connect(watcher, &QFutureWatcher<int>::progressValueChanged, progress, &QProgressDialog::setValue);
+    connect(progress, &QProgressDialog::canceled, watcher, &QFutureWatcher<int>::cancel);
+    connect(watcher, &QFutureWatcher<int>::finished, this, [this, job, progress, watcher]() {
+        progress->close();
+        watcher->deleteLater();
+        if (job.future.isCanceled()) {
+            statusBar()->showMessage(tr("Rendering canceled."), 3000);
+            return;
+        }
+        const FlightPrintRenderer::Result result = job.result();
+        if (result.ok) {
+            QMessageBox::information(this, tr("Success"),
+                tr("Rendered %1 page(s) for %2 flight(s) in %3 s (%4 pages/s).")
+                    .arg(result.pages)
+                    .arg(result.flights)
+                    .arg(result.elapsedMs / 1000.0, 0, 'f', 2)
+                    .arg(result.pagesPerSecond(), 0, 'f', 1));
+        } else {
+            QMessageBox::critical(this, tr("Error"), tr("Failed to render seat maps and manifests."));
+        }
+    });
+    watcher->setFuture(job.future);
+}
+
+void MainWindow::on_actionImportManifest_triggered() {
+    QString filename = QFileDialog::getOpenFileName(this,
+        tr("Import Manifest"), "",
+        tr("CSV Files (*.csv);;All Files (*)"));
+
+    if (filename.isEmpty()) return;
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    if (!airline->ensureAllLoaded()) {
+        QApplication::restoreOverrideCursor();
+        QMessageBox::critical(this, tr("Error"), tr("Failed to load all flights for the import."));
+        return;
+    }
+    const CsvImportResult result = CsvImporter::importManifest(filename, *airline);
+    QApplication::restoreOverrideCursor();
+
+    if (!result.fatalError.isEmpty()) {
+        QMessageBox::critical(this, tr("Error"), tr("Failed to import manifest: %1").arg(result.fatalError));
+        return;
+    }
+
+    updateFlightList();
+    updatePassengerTable();
+    updateSeatMap();
+
+    QString summary = tr("Imported %1 of %2 rows in %3 ms (%4 rows/sec).")
+                          .arg(result.rowsImported)
+                          .arg(result.rowsRead)
+                          .arg(result.elapsedMs)
+                          .arg(qRound64(result.rowsPerSecond()));
+    if (result.errors.empty()) {
+        QMessageBox::information(this, tr("Import Manifest"), summary);
+        return;
+    }
+
+    // Only the first errors are listed; the rest are summarised
+    constexpr size_t kMaxListedErrors = 20;
+    QStringList lines;
+    for (size_t i = 0; i < result.errors.size() && i < kMaxListedErrors; ++i) {
+        lines << tr("Line %1: %2").arg(result.errors[i].line).arg(result.errors[i].message);
+    }
+    if (result.errors.size() > kMaxListedErrors) {
+        lines << tr("...and %1 more.").arg(result.errors.size() - kMaxListedErrors);
+    }
+    QMessageBox box(QMessageBox::Warning, tr("Import Manifest"),
+                    summary + "\n" + tr("%1 rows were rejected.").arg(result.errors.size()),
+                    QMessageBox::Ok, this);
+    box.setDetailedText(lines.join('\n'));
+    box.exec();
+}
+
 void MainWindow::generateReport(const QString& title, const QString& content) {
     QDialog dialog(this);
     dialog.setWindowTitle(title);
@@ -657,7 +1104,7 @@ void MainWindow::updateStatusBar() {
                         .arg([this]() {
                             int total = 0;
                             for (const auto& flight : airline->getFlights()) {
-                                total += flight->getAllPassengers().size();
+                                total += flight->getPassengerCount();
                             }
                             return total;
                         }())
@@ -59,68 +59,11 @@ void PassengerDialog::onTextChanged() {
 void PassengerDialog::updateSeatMap() {
     if (!m_flight || !m_seatMapWidget) return;
 
-    QMap<QString, SeatVisualInfo> seatInfoMap;
-    const auto& seats = m_flight->getSeats();
-
-    // Layout properties
-    const int seat_size = 32;
-    const int seat_spacing = 6;
-    const int aisle_width = 40;
-    const int start_y = 120; // Pushed down for title/legend
-    const int row_height = 40;
-    const int map_width = 800; // The width of the area to center content in
-
-    // Iterate over the seats map
-    for (auto it = seats.cbegin(); it != seats.cend(); ++it) {
-        const auto& seat = it->second;
-        SeatVisualInfo info;
-        info.seatId = seat->getNumber();
-        info.seatClass = seat->getSeatClass();
-        info.price = seat->getPrice();
-        info.occupied = seat->isOccupied();
-
-        int rowNum = info.seatId.chopped(1).toInt();
-        char seatLetter = info.seatId.back().toUpper().toLatin1();
-        
-        int y = start_y + (rowNum - 1) * row_height;
-        int x = 0;
-
-        // Calculate x position based on class layout
-        if (info.seatClass == "First") { // 1-2-1 layout for First Class
-            int total_width = 4 * seat_size + 3 * seat_spacing + 2 * aisle_width;
-            int start_x = (map_width - total_width) / 2;
-            if (seatLetter == 'A') x = start_x;
-            else if (seatLetter == 'D') x = start_x + 1 * (seat_size + seat_spacing) + aisle_width;
-            else if (seatLetter == 'G') x = start_x + 2 * (seat_size + seat_spacing) + aisle_width;
-            else if (seatLetter == 'L') x = start_x + 3 * (seat_size + seat_spacing) + 2 * aisle_width;
-        } else if (info.seatClass == "Business") { // 2-4-2 layout
-            int total_width = 8 * seat_size + 7 * seat_spacing + 2 * aisle_width;
-            int start_x = (map_width - total_width) / 2;
-            if (seatLetter <= 'B') x = start_x + (seatLetter - 'A') * (seat_size + seat_spacing);
-            else if (seatLetter <= 'G') x = start_x + 2 * (seat_size + seat_spacing) + aisle_width + (seatLetter - 'D') * (seat_size + seat_spacing);
-            else { // J, L block
-                int base_x = start_x + 6 * (seat_size + seat_spacing) + 2 * aisle_width;
-                if (seatLetter == 'J') x = base_x;
-                else if (seatLetter == 'L') x = base_x + seat_size + seat_spacing;
-            }
-        } else { // Economy: 3-4-3 layout
-            int total_width = 10 * seat_size + 9 * seat_spacing + 2 * aisle_width;
-            int start_x = (map_width - total_width) / 2;
-            if (seatLetter <= 'C') x = start_x + (seatLetter - 'A') * (seat_size + seat_spacing);
-            else if (seatLetter <= 'G') x = start_x + 3 * (seat_size + seat_spacing) + aisle_width + (seatLetter - 'D') * (seat_size + seat_spacing);
-            else { // H, J, L block
-                int base_x = start_x + 7 * (seat_size + seat_spacing) + 2 * aisle_width;
-                if (seatLetter == 'H') x = base_x;
-                else if (seatLetter == 'J') x = base_x + seat_size + seat_spacing;
-                else if (seatLetter == 'L') x = base_x + 2 * (seat_size + seat_spacing);
-            }
-        }
-
-        info.rect = QRect(x, y, seat_size, seat_size);
-        seatInfoMap[info.seatId] = info;
-    }
-
-    m_seatMapWidget->setSeatLayout(seatInfoMap);
+    // The cabin geometry is shared by every dialog; only per-flight state is built here
+    auto geometry = SeatMapGeometry::forAircraft(Flight::aircraftType());
+    if (!geometry) return;
+    const QVector<SeatState> states = geometry->statesFor(*m_flight);
+    m_seatMapWidget->setSeatGeometry(std::move(geometry), states);
 }
 
 void PassengerDialog::populateFields() {
@@ -181,8 +124,10 @@ PassengerDialog::PassengerDialog(QWidget* parent)
     , m_flight(nullptr)
     , m_passenger(nullptr)
     , m_selectedSeatPrice(0.0)
+    , m_feedTimer(new QTimer(this))
 {
     ui->setupUi(this);
+    connect(m_feedTimer, &QTimer::timeout, this, &PassengerDialog::pollFlightChanges);
 
     // Create a container for the form to style it separately
     QFrame* formContainer = new QFrame();
@@ -199,7 +144,6 @@ PassengerDialog::PassengerDialog(QWidget* parent)
     // Configure the seat map widget
     m_seatMapWidget->setMinimumSize(600, 800);
     m_seatMapWidget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-    m_seatMapWidget->setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
     m_seatMapWidget->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
     m_seatMapWidget->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
     m_seatMapWidget->setFrameStyle(QFrame::NoFrame);
@@ -391,6 +335,7 @@ void PassengerDialog::setFlight(Flight* flight) {
     
     // Update the seat map
     updateSeatMap();
+    followFlightChanges();
     
     // Force update the widget
     if (m_seatMapWidget) {
@@ -408,6 +353,77 @@ void PassengerDialog::setFlight(Flight* flight) {
     }
 }
 
+void PassengerDialog::followFlightChanges() {
+    constexpr int kFeedPollIntervalMs = 100;
+    const ChangeFeed* feed = m_flight ? m_flight->getChangeFeed() : nullptr;
+    if (!feed) {
+        m_feedCursor.reset();
+        m_feedTimer->stop();
+        return;
+    }
+    // The layout was just built from the model, so only later events matter
+    m_feedCursor.emplace(feed->subscribe());
+    m_feedTimer->start(kFeedPollIntervalMs);
+}
+
+void PassengerDialog::pollFlightChanges() {
+    if (!m_flight || !m_feedCursor || !m_seatMapWidget) return;
+
+    m_feedEvents.clear();
+    if (m_feedCursor->poll(m_feedEvents) == ChangeFeed::Cursor::Status::Overrun) {
+        // Missed events: rebuild from the model rather than guess
+        updateSeatMap();
+        if (!m_selectedSeat.isEmpty()) m_seatMapWidget->selectSeat(m_selectedSeat);
+        return;
+    }
+
+    const QString flightNumber = m_flight->getFlightNumber();
+    QVector<SeatOccupancyChange> changes;
+    bool reloadMap = false;
+    auto addChange = [&](const QString& seatNumber) {
+        if (const Seat* seat = m_flight->getSeat(seatNumber)) {
+            changes.append({seatNumber, seat->isOccupied()});
+        }
+    };
+    for (const ChangeEvent& event : m_feedEvents) {
+        switch (event.type) {
+        case ChangeEvent::Type::FlightsReset:
+            // m_flight may no longer exist; stop reading it
+            m_feedCursor.reset();
+            m_feedTimer->stop();
+            return;
+        case ChangeEvent::Type::FlightRemoved:
+        case ChangeEvent::Type::FlightUpdated:
+        case ChangeEvent::Type::FlightUnloaded:
+            // Updates replace the Flight object and unloading empties it, so all end our view of m_flight
+            if (event.flight() == flightNumber || event.detailText() == flightNumber) {
+                m_feedCursor.reset();
+                m_feedTimer->stop();
+                return;
+            }
+            break;
+        case ChangeEvent::Type::FlightAdded:
+            break;
+        case ChangeEvent::Type::PassengersImported:
+            // No per-seat detail; redraw the whole map once the batch is read
+            if (event.flight() == flightNumber) reloadMap = true;
+            break;
+        default:
+            if (event.flight() != flightNumber) break;
+            // The model is read for the current state, so bursts collapse to the final value
+            addChange(event.seat());
+            if (event.type == ChangeEvent::Type::PassengerEdited) addChange(event.detailText());
+            break;
+        }
+    }
+    if (reloadMap) {
+        updateSeatMap();
+        if (!m_selectedSeat.isEmpty()) m_seatMapWidget->selectSeat(m_selectedSeat);
+    } else if (!changes.isEmpty()) {
+        m_seatMapWidget->applyOccupancyChanges(changes);
+    }
+}
+
 void PassengerDialog::onSeatSelected(const QString& seatNumber, double price, const QString& seatClass) {
     m_selectedSeat = seatNumber;
     ui->seatNumberLabel->setText(QString("%1 • %2 • $%3").arg(seatNumber, seatClass, QString::number(price, 'f', 2)));
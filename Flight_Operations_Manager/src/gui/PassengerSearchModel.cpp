@@ -0,0 +1,194 @@
+// This file contains the implementation for the `PassengerSearchModel` class.
+// The index snapshot is refreshed only when the change feed has moved since it was
+// taken, so typing against an unchanged airline never touches the live model, and a
+// refresh copies just the flights named by the events in between.
+
+#include "gui/PassengerSearchModel.h"
+#include "models/Airline.h"
+#include <QSet>
+#include <QTimer>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+
+namespace {
+    // Short enough to stay well inside the keystroke-to-result budget
+    constexpr int kDebounceMs = 30;
+}
+
+PassengerSearchModel::PassengerSearchModel(const Airline& airline, QObject* parent)
+    : QAbstractTableModel(parent)
+    , airline(airline)
+    , debounce(new QTimer(this))
+    , cursor(airline.changeFeed().subscribe())
+{
+    debounce->setSingleShot(true);
+    connect(debounce, &QTimer::timeout, this, &PassengerSearchModel::startSearch);
+    connect(&watcher, &QFutureWatcher<PassengerSearchIndex::Batch>::resultsReadyAt,
+            this, &PassengerSearchModel::batchesReady);
+    connect(&watcher, &QFutureWatcher<PassengerSearchIndex::Batch>::finished,
+            this, &PassengerSearchModel::searchDone);
+}
+
+PassengerSearchModel::~PassengerSearchModel() {
+    cancel();
+    watcher.waitForFinished();
+}
+
+void PassengerSearchModel::setQuery(const QString& query) {
+    pendingQuery = query.trimmed();
+    latency.start();
+    if (pendingQuery.isEmpty()) {
+        debounce->stop();
+        cancel();
+        beginResetModel();
+        rows.clear();
+        std::fill(std::begin(rankEnd), std::end(rankEnd), 0);
+        endResetModel();
+        return;
+    }
+    debounce->start(kDebounceMs);
+}
+
+void PassengerSearchModel::refresh() {
+    if (pendingQuery.isEmpty()) return;
+    debounce->stop();
+    latency.start();
+    startSearch();
+}
+
+void PassengerSearchModel::cancel() {
+    // The worker notices between chunks; nothing waits for it
+    if (watcher.isRunning()) watcher.cancel();
+}
+
+// -----------------------------------------------------------------------------
+// Searching
+// -----------------------------------------------------------------------------
+
+void PassengerSearchModel::startSearch() {
+    // Superseded: its remaining batches are never delivered once the watcher moves on
+    cancel();
+
+    if (!snapshot || snapshot->feedPosition() != airline.changeFeed().head()) {
+        refreshSnapshot();
+    }
+
+    beginResetModel();
+    rows.clear();
+    std::fill(std::begin(rankEnd), std::end(rankEnd), 0);
+    endResetModel();
+    firstResultMs = -1;
+
+    // The worker holds its own reference, so a newer snapshot never pulls this one away
+    const std::shared_ptr<const PassengerSearchIndex> searched = snapshot;
+    const QString query = pendingQuery;
+    watcher.setFuture(QtConcurrent::run(
+        [searched, query](QPromise<PassengerSearchIndex::Batch>& promise) {
+            searched->search(promise, query);
+        }));
+}
+
+void PassengerSearchModel::refreshSnapshot() {
+    events.clear();
+    const bool overrun = cursor.poll(events) == ChangeFeed::Cursor::Status::Overrun;
+    if (!snapshot || overrun) {
+        snapshot = PassengerSearchIndex::build(airline);
+        return;
+    }
+
+    QSet<QString> changed;
+    for (const ChangeEvent& event : events) {
+        switch (event.type) {
+        case ChangeEvent::Type::FlightsReset:
+            snapshot = PassengerSearchIndex::build(airline);
+            return;
+        case ChangeEvent::Type::FlightUnloaded:
+            // Evicted unchanged; the snapshot still holds its passengers
+            break;
+        case ChangeEvent::Type::FlightUpdated:
+            changed.insert(event.detailText());
+            changed.insert(event.flight());
+            break;
+        default:
+            changed.insert(event.flight());
+            break;
+        }
+    }
+    snapshot = PassengerSearchIndex::update(airline, *snapshot, changed);
+}
+
+void PassengerSearchModel::batchesReady(int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        const PassengerSearchIndex::Batch batch = watcher.resultAt(i);
+        // Batches arrive sorted by rank; each run goes to the end of its rank's group
+        for (qsizetype first = 0; first < batch.size();) {
+            const PassengerSearchIndex::Rank rank = batch[first].rank;
+            qsizetype last = first;
+            while (last < batch.size() && batch[last].rank == rank) ++last;
+
+            const int row = rankEnd[rank];
+            const int count = static_cast<int>(last - first);
+            beginInsertRows(QModelIndex(), row, row + count - 1);
+            std::vector<quint32> entries;
+            entries.reserve(static_cast<size_t>(count));
+            for (qsizetype m = first; m < last; ++m) entries.push_back(batch[m].entry);
+            rows.insert(rows.begin() + row, entries.begin(), entries.end());
+            for (int r = rank; r < PassengerSearchIndex::RankCount; ++r) rankEnd[r] += count;
+            endInsertRows();
+            first = last;
+        }
+    }
+    if (firstResultMs < 0 && !rows.empty()) firstResultMs = latency.elapsed();
+}
+
+void PassengerSearchModel::searchDone() {
+    if (watcher.isCanceled()) return;
+    emit searchFinished(static_cast<int>(rows.size()), firstResultMs, latency.elapsed());
+}
+
+// -----------------------------------------------------------------------------
+// Model interface
+// -----------------------------------------------------------------------------
+
+int PassengerSearchModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(rows.size());
+}
+
+int PassengerSearchModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant PassengerSearchModel::data(const QModelIndex& index, int role) const {
+    if (role != Qt::DisplayRole || !index.isValid() || index.row() >= static_cast<int>(rows.size())) {
+        return QVariant();
+    }
+    const quint32 entry = rows[index.row()];
+    switch (index.column()) {
+    case FirstName:    return snapshot->firstName(entry);
+    case LastName:     return snapshot->lastName(entry);
+    case Phone:        return snapshot->phoneNumber(entry);
+    case Seat:         return snapshot->seatNumber(entry);
+    case FlightNumber: return snapshot->flightNumber(entry);
+    }
+    return QVariant();
+}
+
+QVariant PassengerSearchModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal) return QVariant();
+    switch (section) {
+    case FirstName:    return tr("First Name");
+    case LastName:     return tr("Last Name");
+    case Phone:        return tr("Phone");
+    case Seat:         return tr("Seat");
+    case FlightNumber: return tr("Flight");
+    }
+    return QVariant();
+}
+
+QString PassengerSearchModel::flightNumberAt(int row) const {
+    return row >= 0 && row < static_cast<int>(rows.size()) ? snapshot->flightNumber(rows[row]) : QString();
+}
+
+QString PassengerSearchModel::passengerIdAt(int row) const {
+    return row >= 0 && row < static_cast<int>(rows.size()) ? snapshot->seatNumber(rows[row]) : QString();
+}
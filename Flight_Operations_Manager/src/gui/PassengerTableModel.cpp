@@ -0,0 +1,300 @@
+// This file contains the implementation for the `PassengerTableModel` class.
+// Cell text is never stored: data() formats it from the Passenger on demand, so a
+// view only pays for the rows on screen. Change events are folded per flight and
+// each touched flight's ids are diffed against its storage by common prefix and
+// suffix, which turns the usual single add or remove into one row signal.
+
+#include "gui/PassengerTableModel.h"
+#include "models/Airline.h"
+#include "models/Flight.h"
+#include "models/Passenger.h"
+#include <QTimer>
+#include <QSet>
+#include <algorithm>
+#include <utility>
+
+namespace {
+    constexpr int kPollIntervalMs = 100;
+
+    Flight* findFlight(const Airline& airline, const QString& flightNumber) {
+        const auto& flights = airline.getFlights();
+        auto it = std::find_if(flights.rbegin(), flights.rend(),
+                               [&](const auto& f) { return f->getFlightNumber() == flightNumber; });
+        return it != flights.rend() ? it->get() : nullptr;
+    }
+}
+
+PassengerTableModel::PassengerTableModel(const Airline& airline, QObject* parent)
+    : QAbstractTableModel(parent)
+    , airline(airline)
+    , cursor(airline.changeFeed().subscribe())
+    , pollTimer(new QTimer(this))
+{
+    connect(pollTimer, &QTimer::timeout, this, &PassengerTableModel::sync);
+    pollTimer->start(kPollIntervalMs);
+}
+
+void PassengerTableModel::setFlight(Flight* flight) {
+    beginResetModel();
+    cursor = airline.changeFeed().subscribe();
+    airlineWide = false;
+    blocks.clear();
+    if (flight) blocks.push_back(makeBlock(flight));
+    updateOffsets(0);
+    reindexBlocks();
+    endResetModel();
+}
+
+void PassengerTableModel::showAllFlights() {
+    beginResetModel();
+    cursor = airline.changeFeed().subscribe();
+    airlineWide = true;
+    blocks.clear();
+    blocks.reserve(airline.getFlights().size());
+    for (const auto& flight : airline.getFlights())
+        blocks.push_back(makeBlock(flight.get()));
+    updateOffsets(0);
+    reindexBlocks();
+    endResetModel();
+}
+
+// -----------------------------------------------------------------------------
+// Model interface
+// -----------------------------------------------------------------------------
+
+int PassengerTableModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : totalRows;
+}
+
+int PassengerTableModel::columnCount(const QModelIndex& parent) const {
+    if (parent.isValid()) return 0;
+    return airlineWide ? FlightNumber + 1 : Seat + 1;
+}
+
+QVariant PassengerTableModel::data(const QModelIndex& index, int role) const {
+    if (role != Qt::DisplayRole || !index.isValid()) return QVariant();
+    const Passenger* passenger = passengerAt(index.row());
+    if (!passenger) return QVariant();
+
+    switch (index.column()) {
+    case FirstName:    return passenger->getFirstName();
+    case LastName:     return passenger->getLastName();
+    case Phone:        return passenger->getPhoneNumber();
+    case Seat:         return passenger->getSeatNumber();
+    case FlightNumber: return flightNumberAt(index.row());
+    }
+    return QVariant();
+}
+
+QVariant PassengerTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal) return QVariant();
+    switch (section) {
+    case FirstName:    return tr("First Name");
+    case LastName:     return tr("Last Name");
+    case Phone:        return tr("Phone");
+    case Seat:         return tr("Seat");
+    case FlightNumber: return tr("Flight");
+    }
+    return QVariant();
+}
+
+// -----------------------------------------------------------------------------
+// Row lookup
+// -----------------------------------------------------------------------------
+
+int PassengerTableModel::blockForRow(int row) const {
+    if (row < 0 || row >= totalRows) return -1;
+    // The last block starting at or before the row; empty blocks never win ties
+    // because the block holding the row always follows them
+    auto it = std::upper_bound(blocks.begin(), blocks.end(), row,
+                               [](int r, const Block& block) { return r < block.firstRow; });
+    return static_cast<int>(std::distance(blocks.begin(), it)) - 1;
+}
+
+Passenger* PassengerTableModel::passengerAt(int row) const {
+    const int b = blockForRow(row);
+    if (b < 0) return nullptr;
+    const Block& block = blocks[b];
+    const size_t offset = static_cast<size_t>(row - block.firstRow);
+    const QString& id = block.ids[offset];
+
+    // Storage may have moved on since the last sync; fall back to the id
+    if (offset < block.flight->storedPassengerCount()) {
+        Passenger* passenger = block.flight->storedPassenger(offset);
+        if (passenger && passenger->getSeatNumber() == id) return passenger;
+    }
+    return block.flight->getPassenger(id);
+}
+
+QString PassengerTableModel::flightNumberAt(int row) const {
+    const int b = blockForRow(row);
+    return b < 0 ? QString() : blocks[b].flightNumber;
+}
+
+QString PassengerTableModel::passengerIdAt(int row) const {
+    const int b = blockForRow(row);
+    return b < 0 ? QString() : blocks[b].ids[row - blocks[b].firstRow];
+}
+
+int PassengerTableModel::rowOf(const QString& flightNumber, const QString& passengerId) const {
+    const int b = blockIndex.value(flightNumber, -1);
+    if (b < 0 || passengerId.isEmpty()) return -1;
+    const auto& ids = blocks[b].ids;
+    auto it = std::find(ids.begin(), ids.end(), passengerId);
+    return it != ids.end() ? blocks[b].firstRow + static_cast<int>(it - ids.begin()) : -1;
+}
+
+// -----------------------------------------------------------------------------
+// Change tracking
+// -----------------------------------------------------------------------------
+
+void PassengerTableModel::sync() {
+    events.clear();
+    if (cursor.poll(events) == ChangeFeed::Cursor::Status::Overrun) {
+        rebuild();
+        return;
+    }
+    if (events.empty()) return;
+
+    QSet<QString> touched;
+    for (const ChangeEvent& event : events) {
+        switch (event.type) {
+        case ChangeEvent::Type::FlightsReset:
+            // Every Flight object was replaced
+            if (airlineWide) showAllFlights(); else setFlight(nullptr);
+            return;
+        case ChangeEvent::Type::FlightAdded:
+            if (airlineWide && !blockIndex.contains(event.flight())) {
+                insertBlock(static_cast<int>(blocks.size()), findFlight(airline, event.flight()));
+            }
+            break;
+        case ChangeEvent::Type::FlightRemoved: {
+            const int b = blockIndex.value(event.flight(), -1);
+            if (b >= 0) removeBlock(b);
+            touched.remove(event.flight());
+            break;
+        }
+        case ChangeEvent::Type::FlightUnloaded: {
+            // Evicted by the lazy loader; load it back into the same object so the
+            // block's pointer stays valid, then resync as usual
+            const int b = blockIndex.value(event.flight(), -1);
+            if (b < 0) break;
+            airline.getFlight(blocks[b].flightNumber);
+            touched.insert(blocks[b].flightNumber);
+            break;
+        }
+        case ChangeEvent::Type::FlightUpdated: {
+            // The Flight object was replaced in place, possibly under a new number
+            const int b = blockIndex.value(event.detailText(), -1);
+            if (b < 0) break;
+            removeBlock(b);
+            touched.remove(event.detailText());
+            insertBlock(b, findFlight(airline, event.flight()));
+            break;
+        }
+        default:
+            touched.insert(event.flight());
+            break;
+        }
+    }
+
+    for (const QString& flightNumber : std::as_const(touched)) {
+        const int b = blockIndex.value(flightNumber, -1);
+        if (b >= 0) syncBlock(b);
+    }
+}
+
+void PassengerTableModel::rebuild() {
+    if (airlineWide) {
+        showAllFlights();
+        return;
+    }
+    // Keep the flight only if it still belongs to the airline
+    Flight* flight = blocks.empty() ? nullptr : blocks.front().flight;
+    const auto& flights = airline.getFlights();
+    const bool present = flight && std::any_of(flights.begin(), flights.end(),
+                                               [&](const auto& f) { return f.get() == flight; });
+    setFlight(present ? flight : nullptr);
+}
+
+PassengerTableModel::Block PassengerTableModel::makeBlock(Flight* flight) const {
+    Block block;
+    block.flight = flight;
+    block.flightNumber = flight->getFlightNumber();
+    const size_t count = flight->storedPassengerCount();
+    block.ids.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        block.ids.push_back(flight->storedPassenger(i)->getSeatNumber());
+    return block;
+}
+
+void PassengerTableModel::syncBlock(int b) {
+    Block current = makeBlock(blocks[b].flight);
+    std::vector<QString>& ids = blocks[b].ids;
+    const std::vector<QString>& fresh = current.ids;
+
+    size_t prefix = 0;
+    while (prefix < ids.size() && prefix < fresh.size() && ids[prefix] == fresh[prefix]) ++prefix;
+    size_t suffix = 0;
+    while (suffix < ids.size() - prefix && suffix < fresh.size() - prefix
+           && ids[ids.size() - 1 - suffix] == fresh[fresh.size() - 1 - suffix]) ++suffix;
+
+    const int removed = static_cast<int>(ids.size() - prefix - suffix);
+    const int inserted = static_cast<int>(fresh.size() - prefix - suffix);
+    const int first = blocks[b].firstRow + static_cast<int>(prefix);
+
+    if (removed > 0) {
+        beginRemoveRows(QModelIndex(), first, first + removed - 1);
+        ids.erase(ids.begin() + prefix, ids.begin() + prefix + removed);
+        updateOffsets(b + 1);
+        endRemoveRows();
+    }
+    if (inserted > 0) {
+        beginInsertRows(QModelIndex(), first, first + inserted - 1);
+        ids.insert(ids.begin() + prefix, fresh.begin() + prefix, fresh.begin() + prefix + inserted);
+        updateOffsets(b + 1);
+        endInsertRows();
+    }
+    // Passenger details may change without moving, e.g. an edit that keeps the seat
+    if (!ids.empty()) {
+        emit dataChanged(index(blocks[b].firstRow, 0),
+                         index(blocks[b].firstRow + static_cast<int>(ids.size()) - 1, columnCount() - 1));
+    }
+}
+
+void PassengerTableModel::removeBlock(int b) {
+    const int count = static_cast<int>(blocks[b].ids.size());
+    if (count > 0) beginRemoveRows(QModelIndex(), blocks[b].firstRow, blocks[b].firstRow + count - 1);
+    blocks.erase(blocks.begin() + b);
+    updateOffsets(b);
+    reindexBlocks();
+    if (count > 0) endRemoveRows();
+}
+
+void PassengerTableModel::insertBlock(int b, Flight* flight) {
+    if (!flight) return;
+    Block block = makeBlock(flight);
+    const int count = static_cast<int>(block.ids.size());
+    block.firstRow = b < static_cast<int>(blocks.size()) ? blocks[b].firstRow : totalRows;
+    if (count > 0) beginInsertRows(QModelIndex(), block.firstRow, block.firstRow + count - 1);
+    blocks.insert(blocks.begin() + b, std::move(block));
+    updateOffsets(b);
+    reindexBlocks();
+    if (count > 0) endInsertRows();
+}
+
+void PassengerTableModel::updateOffsets(int fromBlock) {
+    int row = fromBlock > 0 ? blocks[fromBlock - 1].firstRow + static_cast<int>(blocks[fromBlock - 1].ids.size()) : 0;
+    for (size_t i = static_cast<size_t>(fromBlock); i < blocks.size(); ++i) {
+        blocks[i].firstRow = row;
+        row += static_cast<int>(blocks[i].ids.size());
+    }
+    totalRows = row;
+}
+
+void PassengerTableModel::reindexBlocks() {
+    blockIndex.clear();
+    blockIndex.reserve(static_cast<qsizetype>(blocks.size()));
+    for (size_t i = 0; i < blocks.size(); ++i)
+        blockIndex.insert(blocks[i].flightNumber, static_cast<int>(i));
+}
@@ -0,0 +1,173 @@
+// This file contains the implementation for the `SeatMapGeometry` class.
+// The cabin is laid out from the Flight model's static row layout, so rows and
+// seat letters come from the layout itself rather than from parsing seat strings.
+
+#include "gui/SeatMapGeometry.h"
+#include "models/Flight.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include <QDebug>
+#include <climits>
+
+namespace {
+    // Keeps the grid small for unusually sparse layouts
+    constexpr int kMaxGridCells = 64 * 1024;
+
+    // Cabin drawing metrics
+    constexpr int kSeatSize = 32;
+    constexpr int kSeatSpacing = 6;
+    constexpr int kAisleWidth = 40;
+    constexpr int kStartY = 120;     // Leaves room for the title and legend
+    constexpr int kRowHeight = 40;
+    constexpr int kMapWidth = 800;   // Width the cabin is centred in
+    constexpr int kPitch = kSeatSize + kSeatSpacing;
+
+    int blockStart(int seatsAcross) {
+        const int totalWidth = seatsAcross * kSeatSize + (seatsAcross - 1) * kSeatSpacing + 2 * kAisleWidth;
+        return (kMapWidth - totalWidth) / 2;
+    }
+
+    // Horizontal position of a seat letter in its class's cabin section
+    int seatX(const QString& seatClass, char letter) {
+        if (seatClass == "First") {  // 1-2-1
+            const int x = blockStart(4);
+            switch (letter) {
+            case 'A': return x;
+            case 'D': return x + 1 * kPitch + kAisleWidth;
+            case 'G': return x + 2 * kPitch + kAisleWidth;
+            case 'L': return x + 3 * kPitch + 2 * kAisleWidth;
+            }
+        } else if (seatClass == "Business") {  // 2-4-2
+            const int x = blockStart(8);
+            if (letter <= 'B') return x + (letter - 'A') * kPitch;
+            if (letter <= 'G') return x + 2 * kPitch + kAisleWidth + (letter - 'D') * kPitch;
+            const int right = x + 6 * kPitch + 2 * kAisleWidth;
+            if (letter == 'J') return right;
+            if (letter == 'L') return right + kPitch;
+        } else {  // 3-4-3
+            const int x = blockStart(10);
+            if (letter <= 'C') return x + (letter - 'A') * kPitch;
+            if (letter <= 'G') return x + 3 * kPitch + kAisleWidth + (letter - 'D') * kPitch;
+            const int right = x + 7 * kPitch + 2 * kAisleWidth;
+            if (letter == 'H') return right;
+            if (letter == 'J') return right + kPitch;
+            if (letter == 'L') return right + 2 * kPitch;
+        }
+        return 0;
+    }
+}
+
+std::shared_ptr<const SeatMapGeometry> SeatMapGeometry::forAircraft(const QString& aircraftType) {
+    static QMutex mutex;
+    static QHash<QString, std::shared_ptr<const SeatMapGeometry>> cache;
+
+    QMutexLocker locker(&mutex);
+    auto it = cache.constFind(aircraftType);
+    if (it != cache.constEnd()) return it.value();
+
+    // Flight models a single cabin today
+    if (aircraftType != Flight::aircraftType()) {
+        qWarning() << "No seat map geometry for aircraft type" << aircraftType;
+        return nullptr;
+    }
+    auto geometry = buildCabin();
+    cache.insert(aircraftType, geometry);
+    return geometry;
+}
+
+std::shared_ptr<const SeatMapGeometry> SeatMapGeometry::buildCabin() {
+    QVector<Seat> seats;
+    for (int row = 1; row <= Flight::layoutRowCount(); ++row) {
+        const QString seatClass = Flight::layoutSeatClass(row);
+        const int y = kStartY + (row - 1) * kRowHeight;
+        for (const QString& letter : Flight::layoutSeatLetters(row)) {
+            Seat seat;
+            seat.seatId = QString::number(row) + letter;
+            seat.seatClass = seatClass;
+            seat.rect = QRect(seatX(seatClass, letter.at(0).toLatin1()), y, kSeatSize, kSeatSize);
+            seats.append(seat);
+        }
+    }
+    return std::make_shared<const SeatMapGeometry>(std::move(seats));
+}
+
+SeatMapGeometry::SeatMapGeometry(QVector<Seat> seats)
+    : m_seats(std::move(seats))
+{
+    m_index.reserve(m_seats.size());
+    for (int i = 0; i < m_seats.size(); ++i) {
+        m_index.insert(m_seats[i].seatId, i);
+    }
+    if (!m_seats.isEmpty()) m_commonSeatSize = m_seats.first().rect.size();
+    buildHitGrid();
+}
+
+QVector<SeatState> SeatMapGeometry::statesFor(const Flight& flight) const {
+    // Both sides are normally in layout order, so the map lookup is only a fallback
+    const std::vector<::Seat*> ordered = flight.getSeatsInLayoutOrder();
+    QVector<SeatState> states(m_seats.size());
+    for (int i = 0; i < m_seats.size(); ++i) {
+        const ::Seat* seat = static_cast<size_t>(i) < ordered.size() ? ordered[i] : nullptr;
+        if (!seat || seat->getNumber() != m_seats[i].seatId) {
+            auto it = flight.getSeats().find(m_seats[i].seatId);
+            seat = it != flight.getSeats().end() ? it->second.get() : nullptr;
+        }
+        if (!seat) continue;
+        states[i].price = seat->getPrice();
+        states[i].occupied = seat->isOccupied();
+    }
+    return states;
+}
+
+int SeatMapGeometry::seatAt(const QPoint& point) const {
+    if (m_hitCells.isEmpty() || !m_bounds.contains(point)) {
+        return -1;
+    }
+    const int column = qMin((point.x() - m_bounds.left()) / m_cellWidth, m_gridColumns - 1);
+    const int row = qMin((point.y() - m_bounds.top()) / m_cellHeight, m_gridRows - 1);
+    // Indexes are ascending, so overlapping seats resolve in layout order
+    for (int index : m_hitCells[row * m_gridColumns + column]) {
+        if (m_seats[index].rect.contains(point)) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+void SeatMapGeometry::buildHitGrid() {
+    int minWidth = INT_MAX, minHeight = INT_MAX;
+    for (const Seat& seat : m_seats) {
+        if (seat.isAisle || seat.rect.isEmpty()) continue;
+        m_bounds = m_bounds.united(seat.rect);
+        minWidth = qMin(minWidth, seat.rect.width());
+        minHeight = qMin(minHeight, seat.rect.height());
+    }
+    if (m_bounds.isEmpty()) return;
+
+    // Cells the size of the smallest seat overlap at most a handful of seats each
+    m_cellWidth = qMax(1, minWidth);
+    m_cellHeight = qMax(1, minHeight);
+    auto columnsFor = [this](int width) { return (m_bounds.width() + width - 1) / width; };
+    auto rowsFor = [this](int height) { return (m_bounds.height() + height - 1) / height; };
+    while (qint64(columnsFor(m_cellWidth)) * rowsFor(m_cellHeight) > kMaxGridCells) {
+        m_cellWidth *= 2;
+        m_cellHeight *= 2;
+    }
+    m_gridColumns = columnsFor(m_cellWidth);
+    m_gridRows = rowsFor(m_cellHeight);
+    m_hitCells.resize(m_gridColumns * m_gridRows);
+
+    for (int index = 0; index < m_seats.size(); ++index) {
+        const Seat& seat = m_seats[index];
+        if (seat.isAisle || seat.rect.isEmpty()) continue;
+        const int firstColumn = (seat.rect.left() - m_bounds.left()) / m_cellWidth;
+        const int lastColumn = qMin((seat.rect.right() - m_bounds.left()) / m_cellWidth, m_gridColumns - 1);
+        const int firstRow = (seat.rect.top() - m_bounds.top()) / m_cellHeight;
+        const int lastRow = qMin((seat.rect.bottom() - m_bounds.top()) / m_cellHeight, m_gridRows - 1);
+        for (int row = firstRow; row <= lastRow; ++row) {
+            for (int column = firstColumn; column <= lastColumn; ++column) {
+                m_hitCells[row * m_gridColumns + column].append(index);
+            }
+        }
+    }
+}
@@ -28,6 +28,28 @@
 #include <QFontMetrics>
 #include <QDateTime>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QSet>
+#include <QPaintEvent>
+#include <QShortcut>
+#include <QSettings>
+#include <QCoreApplication>
+#include <QTextStream>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // The hover outline is stroked on the seat edge and bleeds past the seat rect
+    constexpr int kSeatPaintMargin = 3;
+    // Performance samples kept per metric, and how often the overlay readout refreshes
+    constexpr int kPerfSampleWindow = 1024;
+    constexpr int kOverlayRefreshMs = 250;
+}
+
+Q_LOGGING_CATEGORY(lcSeatMapPerf, "fom.seatmap.perf", QtInfoMsg)
+
+// Atlas rows; seats of any other class use the last row's neutral colour
+const QStringList SeatMapWidget::kSpriteClasses = {"First", "Business", "Premium", "Economy", QString()};
 
 SeatMapWidget::SeatMapWidget(QWidget* parent)
     : QGraphicsView(parent)
@@ -42,7 +64,9 @@ SeatMapWidget::SeatMapWidget(QWidget* parent)
     setAlignment(Qt::AlignTop | Qt::AlignHCenter);
     setBackgroundBrush(QColor("#2c3e50"));
     setMouseTracking(true);
-    setViewportUpdateMode(FullViewportUpdate);
+    // Repaints are invalidated per seat; unchanged seats come from the background cache
+    setViewportUpdateMode(MinimalViewportUpdate);
+    setCacheMode(CacheBackground);
     setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
     
@@ -53,49 +77,143 @@ SeatMapWidget::SeatMapWidget(QWidget* parent)
     font.setFamily("Segoe UI");
     font.setPointSize(9);
     setFont(font);
+
+    m_seatFont = seatLabelFont();
+    const QFontMetricsF metrics(m_seatFont);
+    m_labelAscent = metrics.ascent();
+    m_labelHeight = metrics.height();
+
+    m_perfClock.start();
+    m_overlayTimer = new QTimer(this);
+    m_overlayTimer->setInterval(kOverlayRefreshMs);
+    connect(m_overlayTimer, &QTimer::timeout, this, [this]() { viewport()->update(m_overlayRect); });
+    auto* overlayToggle = new QShortcut(QKeySequence("Ctrl+Shift+P"), this);
+    connect(overlayToggle, &QShortcut::activated, this, [this]() {
+        setPerformanceOverlayEnabled(!m_overlayEnabled);
+    });
+    setPerformanceOverlayEnabled(QSettings().value("seatMap/performanceOverlay", false).toBool());
+}
+
+SeatMapWidget::~SeatMapWidget() {
+    const QString exportFile = QSettings().value("seatMap/performanceExportFile").toString();
+    if (!exportFile.isEmpty() && !m_paintSamples.values.isEmpty()) {
+        exportPerformanceStats(exportFile);
+    }
 }
 
 void SeatMapWidget::setupClassColors() {
-    m_classColors.clear();
-    m_classColors["First"] = QColor("#3498db");     // Royal Blue
-    m_classColors["Business"] = QColor("#8e44ad");  // Wisteria Purple
-    m_classColors["Premium"] = QColor("#16a085");   // Green Sea
-    m_classColors["Economy"] = QColor("#f39c12");   // Orange
-    m_classColors["Selected"] = QColor("#27ae60");  // Nephritis Green
-    m_classColors["Occupied"] = QColor("#95a5a6");  // Concrete Gray
-    m_classColors["Hover"] = QColor("#e74c3c");     // Pomegranate Red
-    m_classColors["Text"] = QColor(255, 255, 255);
-    m_classColors["TextDisabled"] = QColor("#7f8c8d");
+    m_classColors = defaultClassColors();
+    clearSpriteCaches();
+}
+
+QMap<QString, QColor> SeatMapWidget::defaultClassColors() {
+    QMap<QString, QColor> colors;
+    colors["First"] = QColor("#3498db");     // Royal Blue
+    colors["Business"] = QColor("#8e44ad");  // Wisteria Purple
+    colors["Premium"] = QColor("#16a085");   // Green Sea
+    colors["Economy"] = QColor("#f39c12");   // Orange
+    colors["Selected"] = QColor("#27ae60");  // Nephritis Green
+    colors["Occupied"] = QColor("#95a5a6");  // Concrete Gray
+    colors["Hover"] = QColor("#e74c3c");     // Pomegranate Red
+    colors["Text"] = QColor(255, 255, 255);
+    colors["TextDisabled"] = QColor("#7f8c8d");
+    return colors;
+}
+
+QFont SeatMapWidget::seatLabelFont() {
+    return QFont("Segoe UI", 8, QFont::Bold);
 }
 
 void SeatMapWidget::setSeatLayout(const QMap<QString, SeatVisualInfo>& seatInfoMap) {
-    m_seatInfoMap = seatInfoMap;
-
-    if (!m_seatInfoMap.isEmpty()) {
-        QRectF bounds;
-        bool first = true;
-        for (const auto& seat : m_seatInfoMap) {
-            if (first) {
-                bounds = seat.rect;
-                first = false;
-            } else {
-                bounds = bounds.united(seat.rect);
-            }
+    QVector<SeatMapGeometry::Seat> seats;
+    QVector<SeatState> states;
+    seats.reserve(seatInfoMap.size());
+    states.reserve(seatInfoMap.size());
+    for (const auto& info : seatInfoMap) {
+        seats.append({info.seatId, info.seatClass, info.rect, info.isAisle});
+        states.append({info.price, info.occupied});
+    }
+    setSeatGeometry(std::make_shared<const SeatMapGeometry>(std::move(seats)), states);
+}
+
+void SeatMapWidget::setSeatGeometry(std::shared_ptr<const SeatMapGeometry> geometry,
+                                    const QVector<SeatState>& states) {
+    if (geometry && geometry == m_geometry && states.size() == m_states.size()) {
+        // Same cabin: the scene, hit grid and sprites stay; repaint seats that changed
+        for (int i = 0; i < states.size(); ++i) {
+            const bool changed = states[i].occupied != m_states[i].occupied;
+            m_states[i] = states[i];
+            if (changed) invalidateSeatBackground(i);
         }
-        bounds.adjust(-48, -48, 48, 48);
+        return;
+    }
+
+    m_geometry = std::move(geometry);
+    m_states = states;
+    m_states.resize(m_geometry ? m_geometry->size() : 0);
+
+    // Atlases are rendered for the common seat size; other sizes paint as shapes
+    const QSize seatSize = m_geometry ? m_geometry->commonSeatSize() : QSize();
+    if (seatSize != m_spriteSeatSize) {
+        m_spriteSeatSize = seatSize;
+        m_atlases.clear();
+    }
+
+    if (m_geometry && !m_geometry->bounds().isEmpty()) {
+        const QRectF bounds = QRectF(m_geometry->bounds()).adjusted(-48, -48, 48, 48);
         setSceneRect(bounds);
         centerOn(bounds.topLeft());
     }
-    viewport()->update();
+    invalidateSeats();
 }
 
 void SeatMapWidget::setOccupiedSeats(const QVector<QString>& occupied) {
-    for (auto it = m_seatInfoMap.begin(); it != m_seatInfoMap.end(); ++it) {
-        it.value().occupied = occupied.contains(it.key());
+    if (!m_geometry) return;
+    // Diffed against the current state so only seats that flip are repainted
+    const QSet<QString> occupiedSet(occupied.cbegin(), occupied.cend());
+    const auto& seats = m_geometry->seats();
+    for (int i = 0; i < seats.size(); ++i) {
+        const bool isOccupied = occupiedSet.contains(seats[i].seatId);
+        if (m_states[i].occupied != isOccupied) {
+            m_states[i].occupied = isOccupied;
+            invalidateSeatBackground(i);
+        }
+    }
+}
+
+void SeatMapWidget::applyOccupancyChanges(const QVector<SeatOccupancyChange>& changes) {
+    for (const SeatOccupancyChange& change : changes) {
+        setSeatOccupied(change.seatId, change.occupied);
     }
+}
+
+void SeatMapWidget::setSeatOccupied(const QString& seatId, bool occupied) {
+    const int index = m_geometry ? m_geometry->indexOf(seatId) : -1;
+    if (index < 0 || m_states[index].occupied == occupied) return;
+    m_states[index].occupied = occupied;
+    invalidateSeatBackground(index);
+}
+
+void SeatMapWidget::invalidateSeat(const QString& seatId) {
+    const int index = m_geometry && !seatId.isEmpty() ? m_geometry->indexOf(seatId) : -1;
+    if (index < 0) return;
+    const QRectF area = QRectF(m_geometry->seats()[index].rect).adjusted(-kSeatPaintMargin, -kSeatPaintMargin,
+                                                                         kSeatPaintMargin, kSeatPaintMargin);
+    viewport()->update(mapFromScene(area).boundingRect().adjusted(-1, -1, 1, 1));
+}
+
+void SeatMapWidget::invalidateSeats() {
+    resetCachedContent();
     viewport()->update();
 }
 
+void SeatMapWidget::invalidateSeatBackground(int index) {
+    // Re-renders just this seat's patch of the cached background
+    const QRectF area = QRectF(m_geometry->seats()[index].rect).adjusted(-kSeatPaintMargin, -kSeatPaintMargin,
+                                                                         kSeatPaintMargin, kSeatPaintMargin);
+    invalidateScene(area, QGraphicsScene::BackgroundLayer);
+}
+
 void SeatMapWidget::setSeatPrices(const QMap<QString, double>& prices) {
     // This function is now obsolete.
     (void)prices; // Mark as unused
@@ -112,23 +230,26 @@ void SeatMapWidget::setFlightInfo(const QString& flightNumber, const QDateTime&
 
 void SeatMapWidget::mouseMoveEvent(QMouseEvent* event) {
     QPointF scenePos = mapToScene(event->pos());
-    QString newHoveredSeatId = seatAt(scenePos);
+    const int hoveredIndex = seatAt(scenePos);
+    QString newHoveredSeatId = hoveredIndex >= 0 ? m_geometry->seats()[hoveredIndex].seatId : QString();
 
     if (newHoveredSeatId != m_hoveredSeatId) {
+        invalidateSeat(m_hoveredSeatId);
         m_hoveredSeatId = newHoveredSeatId;
-        viewport()->update();
+        invalidateSeat(m_hoveredSeatId);
     }
 
-    if (!m_hoveredSeatId.isEmpty() && m_seatInfoMap.contains(m_hoveredSeatId)) {
-        const auto& seat = m_seatInfoMap[m_hoveredSeatId];
-        if (!seat.occupied) {
+    if (hoveredIndex >= 0) {
+        const auto& seat = m_geometry->seats()[hoveredIndex];
+        const SeatState& state = m_states[hoveredIndex];
+        if (!state.occupied) {
             setCursor(Qt::PointingHandCursor);
             QString tooltipText = QString("<b>Seat:</b> %1<br>"
                                           "<b>Class:</b> %2<br>"
                                           "<b>Price:</b> $%3")
                                           .arg(seat.seatId)
                                           .arg(seat.seatClass)
-                                          .arg(QString::number(seat.price, 'f', 2));
+                                          .arg(QString::number(state.price, 'f', 2));
             QToolTip::showText(event->globalPosition().toPoint(), tooltipText, this);
         } else {
             setCursor(Qt::ForbiddenCursor);
@@ -144,10 +265,10 @@ void SeatMapWidget::mouseMoveEvent(QMouseEvent* event) {
 
 void SeatMapWidget::leaveEvent(QEvent* event) {
     if (!m_hoveredSeatId.isEmpty()) {
+        invalidateSeat(m_hoveredSeatId);
         m_hoveredSeatId.clear();
         unsetCursor();
         QToolTip::hideText();
-        viewport()->update();
     }
     QGraphicsView::leaveEvent(event);
 }
@@ -155,62 +276,232 @@ void SeatMapWidget::leaveEvent(QEvent* event) {
 void SeatMapWidget::mousePressEvent(QMouseEvent* event) {
     if (event->button() == Qt::LeftButton) {
         QPointF scenePos = mapToScene(event->pos());
-        QString seatId = seatAt(scenePos);
-        if (!seatId.isEmpty() && m_seatInfoMap.contains(seatId)) {
-            const auto& seat = m_seatInfoMap[seatId];
-            if (!seat.occupied) {
-                m_selectedSeatId = seatId;
-                emit seatSelected(seatId, seat.price, seat.seatClass);
-                viewport()->update();
+        const int index = seatAt(scenePos);
+        if (index >= 0) {
+            const auto& seat = m_geometry->seats()[index];
+            if (!m_states[index].occupied) {
+                invalidateSeat(m_selectedSeatId);
+                m_selectedSeatId = seat.seatId;
+                invalidateSeat(m_selectedSeatId);
+                emit seatSelected(seat.seatId, m_states[index].price, seat.seatClass);
             }
         }
     }
     QGraphicsView::mousePressEvent(event);
 }
 
+void SeatMapWidget::drawBackground(QPainter* painter, const QRectF& rect) {
+    QGraphicsView::drawBackground(painter, rect);
+    painter->setRenderHint(QPainter::Antialiasing);
+    if (!m_geometry) return;
+    const QRect exposed = rect.toAlignedRect();
+    const auto& seats = m_geometry->seats();
+    for (int i = 0; i < seats.size(); ++i) {
+        if (seats[i].rect.intersects(exposed)) {
+            paintSeat(painter, seats[i], m_states[i].occupied, false, false);
+        }
+    }
+}
+
 void SeatMapWidget::drawForeground(QPainter* painter, const QRectF& rect) {
     // This is for drawing scene content that should scroll and zoom with the scene
     painter->setRenderHint(QPainter::Antialiasing);
-    for (const auto& seatInfo : m_seatInfoMap) {
-        if (seatInfo.rect.intersects(rect.toRect())) {
-            drawSeat(painter, seatInfo, seatInfo.seatId == m_selectedSeatId, seatInfo.seatId == m_hoveredSeatId);
+    if (!m_geometry) return;
+    const QRect exposed = rect.toAlignedRect();
+    for (const QString& seatId : {m_selectedSeatId, m_hoveredSeatId}) {
+        const int index = seatId.isEmpty() ? -1 : m_geometry->indexOf(seatId);
+        if (index < 0) continue;
+        const auto& seat = m_geometry->seats()[index];
+        if (!seat.rect.adjusted(-kSeatPaintMargin, -kSeatPaintMargin,
+                                kSeatPaintMargin, kSeatPaintMargin).intersects(exposed)) {
+            continue;
+        }
+        paintSeat(painter, seat, m_states[index].occupied, seatId == m_selectedSeatId, seatId == m_hoveredSeatId);
+    }
+}
+
+void SeatMapWidget::scrollContentsBy(int dx, int dy) {
+    QGraphicsView::scrollContentsBy(dx, dy);
+    // The viewport is scrolled by copying pixels; the legend is pinned to the
+    // viewport, so repaint both the copy that moved and the place it belongs
+    for (const QRect& pinned : {m_legendRect, m_overlayRect}) {
+        if (!pinned.isNull()) {
+            viewport()->update(pinned.translated(dx, dy));
+            viewport()->update(pinned);
         }
     }
 }
 
 void SeatMapWidget::paintEvent(QPaintEvent* event) {
+    QElapsedTimer timer;
+    timer.start();
+    m_seatsDrawnThisFrame = 0;
+
     // First, run the base class paint event to draw the scene items
     QGraphicsView::paintEvent(event);
 
     // Now, paint the legend on top of the viewport, so it doesn't scroll
-    QPainter painter(this->viewport());
-    drawLegend(&painter, 20, 15);
+    qint64 legendNs = 0;
+    {
+        QPainter painter(this->viewport());
+        QElapsedTimer legendTimer;
+        legendTimer.start();
+        drawLegend(&painter, 20, 15);
+        legendNs = legendTimer.nsecsElapsed();
+    }
+
+    const double elapsedMs = timer.nsecsElapsed() / 1e6;
+
+    // Repaints of the readout alone are not frames worth measuring
+    if (!m_overlayEnabled || !m_overlayRect.contains(event->rect())) {
+        recordFrame(elapsedMs, legendNs / 1e6);
+    }
+    if (m_overlayEnabled) {
+        QPainter painter(this->viewport());
+        drawPerformanceOverlay(&painter);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Sprite atlas and glyph cache
+// -----------------------------------------------------------------------------
+
+void SeatMapWidget::setSpriteRenderingEnabled(bool enabled) {
+    if (m_useSprites == enabled) return;
+    m_useSprites = enabled;
+    invalidateSeats();
+}
+
+void SeatMapWidget::clearSpriteCaches() {
+    m_atlases.clear();
+    m_glyphs.clear();
 }
 
-void SeatMapWidget::drawSeat(QPainter* painter, const SeatVisualInfo& seat, bool isSelected, bool isHovered) {
+void SeatMapWidget::paintSeat(QPainter* painter, const SeatMapGeometry::Seat& seat, bool occupied,
+                              bool isSelected, bool isHovered) {
+    if (seat.isAisle) return;
+    ++m_seatsDrawnThisFrame;
+    const qreal dpr = painter->device()->devicePixelRatioF();
+    // Tiles only match the vector shapes when blitted unscaled
+    if (!m_useSprites || seat.rect.size() != m_spriteSeatSize
+        || painter->transform().type() > QTransform::TxTranslate) {
+        drawSeat(painter, seat, occupied, isSelected, isHovered);
+        return;
+    }
+
+    const SpriteAtlas& atlas = spriteAtlas(dpr);
+    int row = kSpriteClasses.indexOf(seat.seatClass);
+    if (row < 0) row = kSpriteClasses.size() - 1;
+    const SpriteState state = occupied ? Occupied
+        : isSelected && isHovered ? SelectedHovered
+        : isSelected ? Selected
+        : isHovered ? Hovered : Resting;
+
+    // Source rectangles are in the atlas's physical pixels
+    const qreal tile = atlas.tileSize * dpr;
+    const QRectF source(state * tile, row * tile, tile, tile);
+    const QRectF target(seat.rect.x() - kSeatPaintMargin, seat.rect.y() - kSeatPaintMargin,
+                        atlas.tileSize, atlas.tileSize);
+    painter->drawPixmap(target, atlas.pixmap, source);
+    drawLabel(painter, seat.rect, seat.seatId, occupied, dpr);
+}
+
+const SeatMapWidget::SpriteAtlas& SeatMapWidget::spriteAtlas(qreal devicePixelRatio) {
+    auto it = m_atlases.find(devicePixelRatio);
+    if (it != m_atlases.end()) return it.value();
+
+    SpriteAtlas atlas;
+    atlas.seatSize = m_spriteSeatSize;
+    atlas.tileSize = qMax(m_spriteSeatSize.width(), m_spriteSeatSize.height()) + 2 * kSeatPaintMargin;
+    const QSize logicalSize(atlas.tileSize * SpriteStateCount, atlas.tileSize * kSpriteClasses.size());
+    atlas.pixmap = QPixmap(logicalSize * devicePixelRatio);
+    atlas.pixmap.setDevicePixelRatio(devicePixelRatio);
+    atlas.pixmap.fill(Qt::transparent);
+
+    QPainter painter(&atlas.pixmap);
+    for (int row = 0; row < kSpriteClasses.size(); ++row) {
+        for (int state = 0; state < SpriteStateCount; ++state) {
+            SeatMapGeometry::Seat tile;
+            tile.seatClass = kSpriteClasses[row];
+            tile.rect = QRect(QPoint(state * atlas.tileSize + kSeatPaintMargin, row * atlas.tileSize + kSeatPaintMargin),
+                              m_spriteSeatSize);
+            drawSeat(&painter, tile, state == Occupied, state == Selected || state == SelectedHovered,
+                     state == Hovered || state == SelectedHovered, false);
+        }
+    }
+    painter.end();
+    return m_atlases.insert(devicePixelRatio, atlas).value();
+}
+
+const SeatMapWidget::Glyph& SeatMapWidget::glyph(QChar character, bool disabled, qreal devicePixelRatio) {
+    const quint64 key = (quint64(std::lround(devicePixelRatio * 100)) << 32)
+                      | (quint64(disabled) << 16) | character.unicode();
+    auto it = m_glyphs.find(key);
+    if (it != m_glyphs.end()) return it.value();
+
+    Glyph entry;
+    entry.advance = QFontMetricsF(m_seatFont).horizontalAdvance(character);
+    const QSize logicalSize(qCeil(entry.advance) + 2, qCeil(m_labelHeight));
+    entry.pixmap = QPixmap(logicalSize * devicePixelRatio);
+    entry.pixmap.setDevicePixelRatio(devicePixelRatio);
+    entry.pixmap.fill(Qt::transparent);
+
+    QPainter painter(&entry.pixmap);
+    painter.setRenderHint(QPainter::TextAntialiasing);
+    painter.setFont(m_seatFont);
+    painter.setPen(m_classColors.value(disabled ? "TextDisabled" : "Text"));
+    painter.drawText(QPointF(1, m_labelAscent), QString(character));
+    painter.end();
+    return m_glyphs.insert(key, entry).value();
+}
+
+void SeatMapWidget::drawLabel(QPainter* painter, const QRect& rect, const QString& text,
+                              bool disabled, qreal devicePixelRatio) {
+    qreal width = 0.0;
+    for (QChar character : text) {
+        width += glyph(character, disabled, devicePixelRatio).advance;
+    }
+    // Centred like Qt::AlignCenter, snapped to whole device pixels to keep glyphs crisp
+    qreal x = std::round((rect.x() + (rect.width() - width) / 2.0) * devicePixelRatio) / devicePixelRatio;
+    const qreal y = std::round((rect.y() + (rect.height() - m_labelHeight) / 2.0) * devicePixelRatio) / devicePixelRatio;
+    for (QChar character : text) {
+        const Glyph& entry = glyph(character, disabled, devicePixelRatio);
+        painter->drawPixmap(QPointF(x - 1, y), entry.pixmap);
+        x += entry.advance;
+    }
+}
+
+void SeatMapWidget::drawSeat(QPainter* painter, const SeatMapGeometry::Seat& seat, bool occupied,
+                             bool isSelected, bool isHovered, bool drawLabel) {
+    drawSeatShape(painter, seat, m_classColors, m_seatFont, occupied, isSelected, isHovered, drawLabel);
+}
+
+void SeatMapWidget::drawSeatShape(QPainter* painter, const SeatMapGeometry::Seat& seat,
+                                  const QMap<QString, QColor>& colors, const QFont& labelFont,
+                                  bool occupied, bool isSelected, bool isHovered, bool drawLabel) {
     if (seat.isAisle) return;
 
     painter->save();
     painter->setRenderHint(QPainter::Antialiasing, true);
 
-    QColor baseColor = m_classColors.value(seat.seatClass, QColor(200, 200, 200));
+    QColor baseColor = colors.value(seat.seatClass, QColor(200, 200, 200));
     QColor seatColor = baseColor;
     QColor borderColor = baseColor.darker(120);
-    QColor textColor = m_classColors["Text"];
+    QColor textColor = colors.value("Text");
 
-    if (seat.occupied) {
-        seatColor = m_classColors["Occupied"];
+    if (occupied) {
+        seatColor = colors.value("Occupied");
         borderColor = seatColor.darker(110);
-        textColor = m_classColors["TextDisabled"];
+        textColor = colors.value("TextDisabled");
     } else if (isSelected) {
-        seatColor = m_classColors["Selected"];
+        seatColor = colors.value("Selected");
         borderColor = seatColor.darker(120);
     }
     
     QPainterPath path;
     path.addRoundedRect(seat.rect, 8, 8);
     
-    if (isHovered && !seat.occupied) {
+    if (isHovered && !occupied) {
         // A more elegant hover: a bright, accent-colored border
         painter->setPen(QPen(QColor("#f39c12"), 2.5)); // Orange accent border
         painter->drawPath(path);
@@ -225,33 +516,37 @@ void SeatMapWidget::drawSeat(QPainter* painter, const SeatVisualInfo& seat, bool
     painter->setPen(pen);
     painter->drawPath(path);
 
-    QFont seatFont("Segoe UI", 8, QFont::Bold);
-    painter->setFont(seatFont);
-    painter->setPen(textColor);
-    painter->drawText(seat.rect, Qt::AlignCenter, seat.seatId);
+    if (drawLabel) {
+        painter->setFont(labelFont);
+        painter->setPen(textColor);
+        painter->drawText(seat.rect, Qt::AlignCenter, seat.seatId);
+    }
     
     painter->restore();
 }
 
-QString SeatMapWidget::seatAt(const QPointF& scenePos) const {
-    for (auto it = m_seatInfoMap.constBegin(); it != m_seatInfoMap.constEnd(); ++it) {
-        if (it.value().rect.contains(scenePos.toPoint())) {
-            return it.key();
-        }
-    }
-    return QString();
+int SeatMapWidget::seatAt(const QPointF& scenePos) {
+    QElapsedTimer timer;
+    timer.start();
+    const int index = m_geometry ? m_geometry->seatAt(scenePos.toPoint()) : -1;
+    const double elapsedMs = timer.nsecsElapsed() / 1e6;
+    m_hitTestSamples.add(elapsedMs);
+    qCDebug(lcSeatMapPerf) << "hit test" << elapsedMs << "ms";
+    return index;
 }
 
+
 void SeatMapWidget::selectSeat(const QString& seatId) {
-    if (m_seatInfoMap.contains(seatId) || seatId.isEmpty()) {
+    if (seatId.isEmpty() || (m_geometry && m_geometry->indexOf(seatId) >= 0)) {
+        invalidateSeat(m_selectedSeatId);
         m_selectedSeatId = seatId;
-        viewport()->update();
+        invalidateSeat(m_selectedSeatId);
     }
 }
 
 void SeatMapWidget::clearSelection() {
+    invalidateSeat(m_selectedSeatId);
     m_selectedSeatId.clear();
-    viewport()->update();
 }
 
 QString SeatMapWidget::getSelectedSeat() const {
@@ -291,6 +586,7 @@ void SeatMapWidget::drawLegend(QPainter* painter, int x, int y) {
     totalWidth += itemHPadding * 2 - spacing;
 
     QRectF legendBgRect(x - itemHPadding, y - itemVPadding, totalWidth, rectSize + itemVPadding * 2);
+    m_legendRect = legendBgRect.toAlignedRect().adjusted(-1, -1, 1, 1);
     painter->setBrush(QColor(0, 0, 0, 180));
     painter->setPen(Qt::NoPen);
     painter->drawRoundedRect(legendBgRect, 8, 8);
@@ -313,3 +609,146 @@ void SeatMapWidget::drawLegend(QPainter* painter, int x, int y) {
 
     painter->restore();
 }
+
+// -----------------------------------------------------------------------------
+// Performance overlay
+// -----------------------------------------------------------------------------
+
+void SeatMapWidget::RollingSamples::add(double value) {
+    if (values.size() < kPerfSampleWindow) {
+        values.append(value);
+    } else {
+        values[next] = value;
+    }
+    next = (next + 1) % kPerfSampleWindow;
+    ++count;
+    total += value;
+    worst = qMax(worst, value);
+}
+
+double SeatMapWidget::RollingSamples::percentile(double fraction) const {
+    if (values.isEmpty()) return 0.0;
+    // Nearest rank on a copy; the window is small enough to do this per readout
+    QVector<double> sorted = values;
+    const int rank = qBound(0, static_cast<int>(std::ceil(fraction * sorted.size())) - 1, int(sorted.size()) - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    return sorted[rank];
+}
+
+SeatMapWidget::PaintStats SeatMapWidget::paintStats() const {
+    PaintStats stats;
+    stats.frames = m_paintSamples.count;
+    stats.lastMs = m_paintSamples.last();
+    stats.averageMs = stats.frames > 0 ? m_paintSamples.total / stats.frames : 0.0;
+    stats.worstMs = m_paintSamples.worst;
+    return stats;
+}
+
+void SeatMapWidget::setPerformanceOverlayEnabled(bool enabled) {
+    if (m_overlayEnabled == enabled) return;
+    m_overlayEnabled = enabled;
+    if (enabled) {
+        m_overlayTimer->start();
+    } else {
+        m_overlayTimer->stop();
+    }
+    viewport()->update(m_overlayRect.isNull() ? viewport()->rect() : m_overlayRect);
+    if (!enabled) m_overlayRect = QRect();
+}
+
+void SeatMapWidget::recordFrame(double paintMs, double legendMs) {
+    m_paintSamples.add(paintMs);
+    m_seatsDrawnSamples.add(m_seatsDrawnThisFrame);
+    m_legendSamples.add(legendMs);
+
+    // Frame rate only means something while the pointer is over the map
+    if (viewport()->underMouse()) {
+        const qint64 now = m_perfClock.elapsed();
+        m_hoverFrameTimes.append(now);
+        while (m_hoverFrameTimes.first() < now - 1000) m_hoverFrameTimes.removeFirst();
+        m_hoverFpsSamples.add(hoverFramesPerSecond());
+    } else {
+        m_hoverFrameTimes.clear();
+    }
+
+    qCDebug(lcSeatMapPerf).nospace() << "frame " << paintMs << " ms, " << m_seatsDrawnThisFrame
+                                     << " seats drawn, legend " << legendMs << " ms, hover "
+                                     << hoverFramesPerSecond() << " fps";
+}
+
+double SeatMapWidget::hoverFramesPerSecond() const {
+    if (m_hoverFrameTimes.size() < 2) return 0.0;
+    const qint64 span = m_hoverFrameTimes.last() - m_hoverFrameTimes.first();
+    return span > 0 ? (m_hoverFrameTimes.size() - 1) * 1000.0 / span : 0.0;
+}
+
+void SeatMapWidget::drawPerformanceOverlay(QPainter* painter) {
+    const QStringList lines = {
+        QString("Paint   %1 ms  p99 %2").arg(m_paintSamples.last(), 6, 'f', 2)
+                                       .arg(m_paintSamples.percentile(0.99), 6, 'f', 2),
+        QString("Seats   %1 drawn").arg(m_seatsDrawnSamples.last(), 6, 'f', 0),
+        QString("Hit     %1 us  p99 %2").arg(m_hitTestSamples.last() * 1000.0, 6, 'f', 1)
+                                       .arg(m_hitTestSamples.percentile(0.99) * 1000.0, 6, 'f', 1),
+        QString("Hover   %1 fps").arg(hoverFramesPerSecond(), 6, 'f', 1),
+        QString("Legend  %1 ms  p99 %2").arg(m_legendSamples.last(), 6, 'f', 2)
+                                       .arg(m_legendSamples.percentile(0.99), 6, 'f', 2),
+    };
+
+    painter->save();
+    QFont font("Consolas", 9);
+    font.setStyleHint(QFont::Monospace);
+    painter->setFont(font);
+    const QFontMetrics metrics(font);
+
+    // Sized for the widest line the format can produce, so refreshes cover it exactly
+    const int padding = 8;
+    const int textWidth = metrics.horizontalAdvance(QString(32, QLatin1Char('0')));
+    const QRect box(viewport()->width() - textWidth - 2 * padding - 12, 12,
+                    textWidth + 2 * padding, int(lines.size()) * metrics.height() + 2 * padding);
+    m_overlayRect = box.adjusted(-1, -1, 1, 1);
+
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(QColor(0, 0, 0, 180));
+    painter->drawRoundedRect(box, 6, 6);
+    painter->setPen(QColor("#ecf0f1"));
+    int y = box.top() + padding + metrics.ascent();
+    for (const QString& line : lines) {
+        painter->drawText(box.left() + padding, y, line);
+        y += metrics.height();
+    }
+    painter->restore();
+}
+
+bool SeatMapWidget::exportPerformanceStats(const QString& path) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        qWarning() << "Failed to export seat map performance stats to" << path;
+        return false;
+    }
+
+    const QPair<QString, const RollingSamples*> metrics[] = {
+        {"paint_ms", &m_paintSamples},
+        {"seats_drawn", &m_seatsDrawnSamples},
+        {"hit_test_ms", &m_hitTestSamples},
+        {"hover_fps", &m_hoverFpsSamples},
+        {"legend_ms", &m_legendSamples},
+    };
+    QTextStream out(&file);
+    out << "# run " << QDateTime::currentDateTime().toString(Qt::ISODateWithMs)
+        << " pid " << QCoreApplication::applicationPid()
+        << " frames " << m_paintSamples.count << '\n';
+    out << "metric,samples,p50,p90,p99,max\n";
+    for (const auto& metric : metrics) {
+        const RollingSamples& samples = *metric.second;
+        out << metric.first << ',' << samples.values.size() << ','
+            << samples.percentile(0.5) << ',' << samples.percentile(0.9) << ','
+            << samples.percentile(0.99) << ',' << samples.percentile(1.0) << '\n';
+    }
+    out.flush();
+    if (out.status() != QTextStream::Ok) {
+        qWarning() << "Failed to export seat map performance stats to" << path;
+        return false;
+    }
+    return true;
+}
@@ -5,6 +5,8 @@
 
 int main(int argc, char *argv[]) {
     QApplication app(argc, argv);
+    app.setOrganizationName("FlightOperations");
+    app.setApplicationName("Flight Operations Manager");
     
     MainWindow window;
     window.show();
@@ -3,6 +3,7 @@
 // It includes methods for managing airline properties like name, IATA code, and contact.
 
 #include "models/Airline.h"
+#include "database/OperationLog.h"
 #include <algorithm>
 
 Airline::Airline(const QString& name) : name(name) {}
@@ -12,25 +13,41 @@ Flight* Airline::getFlight(const QString& id) const {
                            [&](const auto& flight) {
                                return flight->getFlightNumber() == id;
                            });
-    return it != flights.end() ? it->get() : nullptr;
+    if (it == flights.end()) return nullptr;
+    if (loader && !materialize(it->get())) return nullptr;
+    return it->get();
 }
 
 bool Airline::addFlight(std::unique_ptr<Flight> flight) {
     if (!flight) return false;
     if (flight->getFlightNumber().isEmpty()) return false;
     if (getFlight(flight->getFlightNumber())) return false;
+    removedFlights.remove(flight->getFlightNumber());
+    flight->markDirty();
+    flight->setChangeFeed(&feed);
+    if (operationLog) operationLog->logAddFlight(*flight);
+    feed.publish(ChangeEvent::Type::FlightAdded, flight->getFlightNumber());
     flights.push_back(std::move(flight));
     return true;
 }
 
 void Airline::removeFlight(const QString& id) {
     if (id.isEmpty()) return;
+    // Only the header is needed; loading a flight just to delete it could fail
+    auto existing = std::find_if(flights.begin(), flights.end(),
+                                 [&](const auto& flight) { return flight && flight->getFlightNumber() == id; });
+    if (existing == flights.end()) return;
+    removedFlights.insert(id);
+    if (operationLog) operationLog->logRemoveFlight(id);
     flights.erase(
         std::remove_if(flights.begin(), flights.end(),
                        [&](const auto& flight) {
-                           return flight && flight->getFlightNumber() == id;
+                           if (!flight || flight->getFlightNumber() != id) return false;
+                           forgetResident(flight.get());
+                           return true;
                        }),
         flights.end());
+    feed.publish(ChangeEvent::Type::FlightRemoved, id);
 }
 
 bool Airline::updateFlight(const QString& flightNumber, std::unique_ptr<Flight> newFlight) {
@@ -40,12 +57,122 @@ bool Airline::updateFlight(const QString& flightNumber, std::unique_ptr<Flight>
                                return f && f->getFlightNumber() == flightNumber;
                            });
     if (it == flights.end()) return false;
+    if (newFlight->getFlightNumber() != flightNumber) removedFlights.insert(flightNumber);
+    removedFlights.remove(newFlight->getFlightNumber());
+    newFlight->markDirty();
+    newFlight->setChangeFeed(&feed);
+    if (operationLog) operationLog->logUpdateFlight(flightNumber, *newFlight);
+    forgetResident(it->get());
+    feed.publish(ChangeEvent::Type::FlightUpdated, newFlight->getFlightNumber(), QString(), flightNumber);
     *it = std::move(newFlight);
     return true;
 }
 
 void Airline::setFlights(std::vector<std::unique_ptr<Flight>>&& newFlights) {
+    // A new flight set invalidates any loader tied to the previous one
+    loader = nullptr;
+    bulkLoader = nullptr;
+    residentFlights.clear();
+    residentIndex.clear();
     flights = std::move(newFlights);
+    for (const auto& flight : flights)
+        flight->setChangeFeed(&feed);
+    feed.publish(ChangeEvent::Type::FlightsReset, QString());
+}
+
+// -----------------------------------------------------------------------------
+// Lazy loading
+// -----------------------------------------------------------------------------
+
+void Airline::setFlightLoader(FlightLoader newLoader, size_t newMaxResident, BulkLoader newBulkLoader) {
+    loader = std::move(newLoader);
+    bulkLoader = std::move(newBulkLoader);
+    maxResident = qMax<size_t>(1, newMaxResident);
+    residentFlights.clear();
+    residentIndex.clear();
+    for (const auto& flight : flights) {
+        if (flight->isLoaded()) {
+            residentIndex.insert(flight.get(), residentFlights.insert(residentFlights.end(), flight.get()));
+        }
+    }
+}
+
+bool Airline::hasUnloadedFlights() const {
+    return std::any_of(flights.begin(), flights.end(),
+                       [](const auto& flight) { return !flight->isLoaded(); });
+}
+
+bool Airline::materialize(Flight* flight) const {
+    auto resident = residentIndex.find(flight);
+    if (resident != residentIndex.end()) {
+        residentFlights.splice(residentFlights.begin(), residentFlights, resident.value());
+        return true;
+    }
+
+    if (!flight->isLoaded()) {
+        std::unique_ptr<Flight> full = loader(flight->getFlightNumber());
+        if (!full) return false;
+        // Moved into the header so pointers to the Flight stay valid
+        *flight = std::move(*full);
+        flight->clearDirty();
+        flight->setChangeFeed(&feed);
+    }
+    residentIndex.insert(flight, residentFlights.insert(residentFlights.begin(), flight));
+
+    // Evict least recently used flights; unsaved ones stay until they are saved
+    for (auto it = std::prev(residentFlights.end());
+         residentFlights.size() > maxResident && it != residentFlights.begin();) {
+        Flight* candidate = *it;
+        auto previous = std::prev(it);
+        if (!candidate->isDirty()) {
+            candidate->unload();
+            residentIndex.remove(candidate);
+            residentFlights.erase(it);
+        }
+        it = previous;
+    }
+    return true;
+}
+
+void Airline::forgetResident(Flight* flight) const {
+    auto it = residentIndex.find(flight);
+    if (it != residentIndex.end()) {
+        residentFlights.erase(it.value());
+        residentIndex.erase(it);
+    }
+}
+
+bool Airline::ensureAllLoaded() {
+    if (!loader) return true;
+
+    // With most flights still on disk, one bulk load beats inflating them one by one
+    QHash<QString, Flight*> loaded;
+    std::vector<std::unique_ptr<Flight>> all;
+    const auto unloaded = std::count_if(flights.begin(), flights.end(),
+                                        [](const auto& flight) { return !flight->isLoaded(); });
+    if (bulkLoader && static_cast<size_t>(unloaded) * 2 > flights.size() && bulkLoader(all)) {
+        loaded.reserve(static_cast<qsizetype>(all.size()));
+        for (const auto& flight : all) loaded.insert(flight->getFlightNumber(), flight.get());
+    }
+
+    for (const auto& flight : flights) {
+        if (flight->isLoaded()) continue;  // Resident copies may hold unsaved changes
+        std::unique_ptr<Flight> single;
+        Flight* full = loaded.value(flight->getFlightNumber());
+        if (!full) {
+            single = loader(flight->getFlightNumber());
+            full = single.get();
+        }
+        if (!full) return false;
+        *flight = std::move(*full);
+        flight->clearDirty();
+        flight->setChangeFeed(&feed);
+    }
+    loader = nullptr;
+    bulkLoader = nullptr;
+    residentFlights.clear();
+    residentIndex.clear();
+    return true;
 }
 
 std::vector<Flight*> Airline::searchFlights(const QString& query) const {
@@ -68,6 +195,7 @@ std::vector<Passenger*> Airline::searchPassengers(const QString& query) const {
     QString lowercaseQuery = query.toLower();
 
     for (const auto& flight : flights) {
+        if (!flight->isLoaded()) continue;  // Headers carry no passengers
         for (const auto& passenger : flight->getAllPassengers()) {
             if (passenger->getFirstName().toLower().contains(lowercaseQuery) ||
                 passenger->getLastName().toLower().contains(lowercaseQuery) ||
@@ -83,19 +211,78 @@ std::vector<Passenger*> Airline::searchPassengers(const QString& query) const {
 bool Airline::addPassenger(std::unique_ptr<Passenger> passenger, const QString& flightNumber) {
     if (auto flight = getFlight(flightNumber)) {
         if (passenger) {
-            return flight->addPassenger(std::move(passenger));
+            const Passenger* added = passenger.get();
+            if (!flight->addPassenger(std::move(passenger))) return false;
+            if (operationLog) operationLog->logAddPassenger(flightNumber, *added);
+            return true;
         }
     }
     return false;
 }
 
+std::vector<size_t> Airline::addPassengers(const QString& flightNumber,
+                                           std::vector<std::unique_ptr<Passenger>> passengers) {
+    std::vector<size_t> rejected;
+    Flight* flight = getFlight(flightNumber);
+    if (!flight) {
+        for (size_t i = 0; i < passengers.size(); ++i) rejected.push_back(i);
+        return rejected;
+    }
+
+    // Logged and published once for the whole batch; a record and two events per
+    // row would cost a write each and lap every observer's cursor on a large import
+    std::vector<const Passenger*> added;
+    added.reserve(passengers.size());
+    flight->reservePassengers(passengers.size());
+    flight->setChangeFeed(nullptr);
+    for (size_t i = 0; i < passengers.size(); ++i) {
+        const Passenger* passenger = passengers[i].get();
+        if (!passenger || !flight->addPassenger(std::move(passengers[i]))) {
+            rejected.push_back(i);
+            continue;
+        }
+        added.push_back(passenger);
+    }
+    flight->setChangeFeed(&feed);
+
+    if (!added.empty()) {
+        if (operationLog) operationLog->logAddPassengers(flightNumber, added);
+        feed.publish(ChangeEvent::Type::PassengersImported, flightNumber);
+    }
+    return rejected;
+}
+
 bool Airline::removePassenger(const QString& passengerId, const QString& flightNumber) {
     if (auto flight = getFlight(flightNumber)) {
-        return flight->removePassenger(passengerId);
+        if (!flight->removePassenger(passengerId)) return false;
+        if (operationLog) operationLog->logRemovePassenger(flightNumber, passengerId);
+        return true;
     }
     return false;
 }
 
+bool Airline::updatePassenger(const QString& passengerId, std::unique_ptr<Passenger> newPassenger,
+                              const QString& flightNumber) {
+    Flight* flight = getFlight(flightNumber);
+    if (!flight || !newPassenger) return false;
+    const Passenger* current = flight->getPassenger(passengerId);
+    if (!current) return false;
+
+    auto original = std::make_unique<Passenger>(*current);
+    const Passenger* updated = newPassenger.get();
+    flight->removePassenger(passengerId);
+    if (!flight->addPassenger(std::move(newPassenger))) {
+        flight->addPassenger(std::move(original)); // restore
+        return false;
+    }
+    if (operationLog) {
+        operationLog->logRemovePassenger(flightNumber, passengerId);
+        operationLog->logAddPassenger(flightNumber, *updated);
+    }
+    feed.publish(ChangeEvent::Type::PassengerEdited, flightNumber, updated->getSeatNumber(), passengerId);
+    return true;
+}
+
 Passenger* Airline::getPassenger(const QString& passengerId, const QString& flightNumber) const {
     if (auto flight = getFlight(flightNumber)) {
         return flight->getPassenger(passengerId);
@@ -106,6 +293,7 @@ Passenger* Airline::getPassenger(const QString& passengerId, const QString& flig
 std::vector<Passenger*> Airline::getAllPassengers() const {
     std::vector<Passenger*> allPassengers;
     for (const auto& flight : flights) {
+        if (!flight->isLoaded()) continue;
         auto passengers = flight->getAllPassengers();
         allPassengers.insert(allPassengers.end(), passengers.begin(), passengers.end());
     }
@@ -115,7 +303,9 @@ std::vector<Passenger*> Airline::getAllPassengers() const {
 bool Airline::bookSeat(const QString& flightNumber, const QString& passengerId, const QString& seatNumber) {
     if (auto flight = getFlight(flightNumber)) {
         if (auto passenger = flight->getPassenger(passengerId)) {
-            return flight->assignSeat(passenger, seatNumber);
+            if (!flight->assignSeat(passenger, seatNumber)) return false;
+            if (operationLog) operationLog->logBookSeat(flightNumber, passengerId, seatNumber);
+            return true;
         }
     }
     return false;
@@ -124,7 +314,9 @@ bool Airline::bookSeat(const QString& flightNumber, const QString& passengerId,
 bool Airline::cancelBooking(const QString& flightNumber, const QString& passengerId) {
     if (auto flight = getFlight(flightNumber)) {
         if (auto passenger = flight->getPassenger(passengerId)) {
-            passenger->unassignSeat();
+            // Release through the flight so the seat is freed and the flight marked dirty
+            if (!flight->unassignSeat(passenger->getSeatNumber())) return false;
+            if (operationLog) operationLog->logCancelBooking(flightNumber, passengerId);
             return true;
         }
     }
@@ -135,11 +327,12 @@ bool Airline::changeBooking(const QString& flightNumber, const QString& passenge
     if (auto flight = getFlight(flightNumber)) {
         if (auto passenger = flight->getPassenger(passengerId)) {
             QString oldSeat = passenger->getSeatNumber();
-            passenger->unassignSeat();
+            flight->unassignSeat(oldSeat);
             if (!flight->assignSeat(passenger, newSeatNumber)) {
                 flight->assignSeat(passenger, oldSeat); // restore
                 return false;
             }
+            if (operationLog) operationLog->logChangeBooking(flightNumber, passengerId, newSeatNumber);
             return true;
         }
     }
@@ -190,3 +383,27 @@ const std::vector<std::unique_ptr<Flight>>& Airline::getFlights() const {
     return flights;
 }
 
+std::vector<Flight*> Airline::getDirtyFlights() const {
+    std::vector<Flight*> dirty;
+    for (const auto& flight : flights) {
+        if (flight->isDirty())
+            dirty.push_back(flight.get());
+    }
+    return dirty;
+}
+
+QStringList Airline::getRemovedFlights() const {
+    return QStringList(removedFlights.begin(), removedFlights.end());
+}
+
+bool Airline::hasUnsavedChanges() const {
+    if (!removedFlights.isEmpty()) return true;
+    return std::any_of(flights.begin(), flights.end(),
+                       [](const auto& flight) { return flight->isDirty(); });
+}
+
+void Airline::markClean() {
+    for (const auto& flight : flights)
+        flight->clearDirty();
+    removedFlights.clear();
+}
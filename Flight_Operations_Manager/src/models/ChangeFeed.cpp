@@ -0,0 +1,116 @@
+// This file contains the implementation for the `ChangeFeed` class.
+// Producers claim a sequence number with one atomic increment and publish the slot
+// seqlock-style: the slot version is cleared while the event is written and set to
+// sequence + 1 afterwards. Readers copy the event and accept it only if the version
+// was the expected one both before and after the copy.
+
+#include "models/ChangeFeed.h"
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <cstring>
+
+namespace {
+    size_t roundUpToPowerOfTwo(size_t value) {
+        size_t result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+}
+
+ChangeFeed::ChangeFeed(size_t capacity)
+    : slots(new Slot[roundUpToPowerOfTwo(qMax<size_t>(capacity, 2))])
+    , mask(roundUpToPowerOfTwo(qMax<size_t>(capacity, 2)) - 1)
+{
+}
+
+void ChangeFeed::publish(ChangeEvent::Type type, const QString& flightNumber,
+                         const QString& seatNumber, const QString& detail) {
+    const quint64 sequence = claimed.fetch_add(1, std::memory_order_acq_rel);
+    Slot& slot = slots[sequence & mask];
+
+    slot.version.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    ChangeEvent& event = slot.event;
+    event.sequence = sequence;
+    event.type = type;
+    event.feed = this;
+    store(event.flightNumber, flightNumber);
+    store(event.seatNumber, seatNumber);
+    store(event.detail, detail);
+
+    slot.version.store(sequence + 1, std::memory_order_release);
+}
+
+template <size_t N>
+void ChangeFeed::store(ChangeText<N>& field, const QString& text) {
+    // Inline only if every character survives the round trip through Latin-1
+    bool fits = text.size() < static_cast<qsizetype>(N);
+    for (qsizetype i = 0; fits && i < text.size(); ++i) {
+        const ushort code = text.at(i).unicode();
+        fits = code != 0 && code < 0x100;
+    }
+    if (!fits) {
+        field.interned = intern(text) + 1;
+        field.text[0] = '\0';
+        return;
+    }
+    const QChar* in = text.constData();
+    for (qsizetype i = 0; i < text.size(); ++i)
+        field.text[i] = static_cast<char>(in[i].unicode());
+    field.text[text.size()] = '\0';
+    field.interned = 0;
+}
+
+quint32 ChangeFeed::intern(const QString& text) {
+    {
+        QReadLocker locker(&internLock);
+        auto it = internIndex.constFind(text);
+        if (it != internIndex.constEnd()) return it.value();
+    }
+    QWriteLocker locker(&internLock);
+    auto it = internIndex.constFind(text);
+    if (it != internIndex.constEnd()) return it.value();
+    const quint32 index = static_cast<quint32>(internTable.size());
+    internTable.push_back(text);
+    internIndex.insert(text, index);
+    return index;
+}
+
+QString ChangeFeed::internedText(quint32 index) const {
+    QReadLocker locker(&internLock);
+    return index < internTable.size() ? internTable[index] : QString();
+}
+
+ChangeFeed::Cursor::Status ChangeFeed::Cursor::poll(std::vector<ChangeEvent>& out, size_t maxEvents) {
+    const quint64 head = feed->head();
+    if (head - next > feed->capacity()) {
+        next = head - feed->capacity();
+        return Status::Overrun;
+    }
+
+    for (size_t taken = 0; next < head && taken < maxEvents; ++taken) {
+        const Slot& slot = feed->slots[next & feed->mask];
+        const quint64 before = slot.version.load(std::memory_order_acquire);
+        if (before != next + 1) {
+            if (before > next + 1) {
+                // Overwritten by a producer that lapped this cursor
+                next = feed->head() - qMin<quint64>(feed->head(), feed->capacity());
+                return Status::Overrun;
+            }
+            break;  // Claimed but not yet published
+        }
+
+        ChangeEvent event;
+        std::memcpy(&event, &slot.event, sizeof(ChangeEvent));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.version.load(std::memory_order_relaxed) != before) {
+            next = feed->head() - qMin<quint64>(feed->head(), feed->capacity());
+            return Status::Overrun;
+        }
+
+        out.push_back(event);
+        ++next;
+    }
+    return Status::Ok;
+}
@@ -11,6 +11,7 @@
 #include <QStringList>
 #include <QMap>
 #include <QRandomGenerator>
+#include <utility>
 
 // -----------------------------------------------------------------------------
 // Boeing 777-300ER seat-map layout configuration
@@ -45,6 +46,13 @@ namespace {
         // Economy default
         return {"A","B","C","D","E","F","G","H","J","L"};
     }
+
+    QString seatClassForRow(int row) {
+        if (row <= 7) return "First";
+        if (row <= 11) return "Business";
+        if (row <= 18) return "Premium";
+        return "Economy";
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -67,47 +75,145 @@ Flight::Flight(const QString& flightNumber,
     initializeSeats();
 }
 
-void Flight::initializeSeats() {
+Flight::Flight(HeaderOnly,
+               const QString& flightNumber,
+               const QString& origin,
+               const QString& destination,
+               const QDateTime& departureTime,
+               int passengerCount)
+    : flightNumber(flightNumber)
+    , origin(origin)
+    , destination(destination)
+    , departureTime(departureTime)
+    , rows(kRows)
+    , cols(kCols)
+    , basePrice(500.0)
+    , dirty(false)
+    , loaded(false)
+    , headerPassengerCount(passengerCount)
+{
+}
+
+std::unique_ptr<Flight> Flight::createHeader(const QString& flightNumber,
+                                             const QString& origin,
+                                             const QString& destination,
+                                             const QDateTime& departureTime,
+                                             int passengerCount) {
+    return std::unique_ptr<Flight>(new Flight(HeaderOnly{}, flightNumber, origin, destination,
+                                              departureTime, passengerCount));
+}
+
+void Flight::unload() {
+    headerPassengerCount = static_cast<int>(passengers.size());
+    // Seats point at passengers, so they go first
     seats.clear();
+    passengers.clear();
+    loaded = false;
+    // Views indexing this flight's storage must let go of it or reload it
+    publish(ChangeEvent::Type::FlightUnloaded, QString());
+}
+
+void Flight::initializeSeats() {
+    createSeats();
     QRandomGenerator* gen = QRandomGenerator::global();
 
     for (int r = 1; r <= kRows; ++r) {
-        QStringList letters = getSeatLettersForRow(r);
-        QString seatClass;
         double price;
         
-        // Determine seat class and price based on row and basePrice
+        // Determine seat price based on row and basePrice
         if (r <= 7) {
-            seatClass = "First";
             // e.g., for a 500 base: 1500 + (0 to 499)
             price = (basePrice * 3.0) + gen->bounded(static_cast<int>(basePrice)); 
         } else if (r <= 11) {
-            seatClass = "Business";
             // e.g., for a 500 base: 1000 + (0 to 249)
             price = (basePrice * 2.0) + gen->bounded(static_cast<int>(basePrice / 2.0));
         } else if (r <= 18) {
-            seatClass = "Premium";
             // e.g., for a 500 base: 750 + (0 to 199)
             price = (basePrice * 1.5) + gen->bounded(static_cast<int>(basePrice / 2.5));
         } else {
-            seatClass = "Economy";
             // e.g., for a 500 base: 500 + (0 to 99)
             price = basePrice + gen->bounded(static_cast<int>(basePrice / 5.0));
         }
         
-        for (const QString& letter : letters) {
-            QString sn = QString::number(r) + letter;
-            auto seat = std::make_unique<Seat>(sn, seatClass, r, letters.indexOf(letter));
-            seat->setPrice(price);
-            // The seat class is already set in the constructor, but this is fine.
-            seat->setSeatClass(seatClass); 
-            seats[sn] = std::move(seat);
+        for (const QString& letter : getSeatLettersForRow(r)) {
+            seats[QString::number(r) + letter]->setPrice(price);
+        }
+    }
+}
+
+void Flight::createSeats() {
+    seats.clear();
+    for (int r = 1; r <= kRows; ++r) {
+        const QStringList letters = getSeatLettersForRow(r);
+        const QString seatClass = seatClassForRow(r);
+        for (int c = 0; c < letters.size(); ++c) {
+            QString sn = QString::number(r) + letters[c];
+            seats[sn] = std::make_unique<Seat>(sn, seatClass, r, c);
         }
     }
     rows = kRows;
     cols = kCols;
 }
 
+std::vector<Seat*> Flight::getSeatsInLayoutOrder() const {
+    std::vector<Seat*> ordered;
+    ordered.reserve(seats.size());
+    for (int r = 1; r <= rows; ++r) {
+        for (const QString& letter : getSeatLettersForRow(r)) {
+            auto it = seats.find(QString::number(r) + letter);
+            if (it != seats.end())
+                ordered.push_back(it->second.get());
+        }
+    }
+    return ordered;
+}
+
+std::unique_ptr<Flight> Flight::restore(const QString& flightNumber,
+                                        const QString& origin,
+                                        const QString& destination,
+                                        const QDateTime& departureTime,
+                                        double basePrice,
+                                        const std::vector<Seat::Status>& statuses,
+                                        const std::vector<double>& prices,
+                                        std::vector<std::unique_ptr<Passenger>>&& passengers) {
+    std::unique_ptr<Flight> flight(new Flight(HeaderOnly{}, flightNumber, origin, destination,
+                                              departureTime, 0));
+    flight->basePrice = basePrice;
+    flight->createSeats();
+
+    const std::vector<Seat*> ordered = flight->getSeatsInLayoutOrder();
+    if (statuses.size() != ordered.size() || prices.size() != ordered.size()) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < ordered.size(); ++i) {
+        ordered[i]->setPrice(prices[i]);
+        // Occupied seats are taken by their passengers below
+        if (statuses[i] == Seat::Status::Reserved) ordered[i]->reserve();
+        else if (statuses[i] == Seat::Status::Blocked) ordered[i]->block();
+    }
+
+    flight->passengers.reserve(passengers.size());
+    for (auto& passenger : std::exchange(passengers, {})) {
+        if (!passenger) continue;
+        const QString sn = passenger->getSeatNumber();
+        if (!sn.isEmpty()) {
+            auto it = flight->seats.find(sn);
+            // Same outcome as addPassenger() for a seat that is already taken
+            if (it == flight->seats.end() || !it->second->setPassenger(passenger.get())) continue;
+        }
+        flight->passengers.push_back(std::move(passenger));
+    }
+
+    flight->loaded = true;
+    flight->dirty = true;  // Like any new flight until the caller marks it clean
+    return flight;
+}
+
+void Flight::publish(ChangeEvent::Type type, const QString& seatNumber) const {
+    if (changeFeed)
+        changeFeed->publish(type, flightNumber, seatNumber);
+}
+
 QString Flight::generateSeatNumber(int row, int col) const {
     // row/col are zero-based
     QStringList letters = getSeatLettersForRow(row+1);
@@ -128,6 +234,43 @@ bool Flight::isSeatValid(const QString& seatNumber) const {
     return seats.find(seatNumber) != seats.end();
 }
 
+bool Flight::isLayoutSeat(QByteArrayView seatNumber) {
+    // Row digits without a leading zero followed by exactly one seat letter
+    const qsizetype length = seatNumber.size();
+    if (length < 2 || length > 3 || seatNumber[0] == '0') return false;
+    int row = 0;
+    for (qsizetype i = 0; i < length - 1; ++i) {
+        const char c = seatNumber[i];
+        if (c < '0' || c > '9') return false;
+        row = row * 10 + (c - '0');
+    }
+    if (row < 1 || row > kRows) return false;
+
+    // Same letter sets as getSeatLettersForRow()
+    const char* letters = row <= 7 ? "ADGL" : row <= 18 ? "ABDEFGJL" : "ABCDEFGHJL";
+    const char letter = seatNumber[length - 1];
+    for (const char* p = letters; *p; ++p) {
+        if (*p == letter) return true;
+    }
+    return false;
+}
+
+QString Flight::aircraftType() {
+    return QStringLiteral("Boeing 777-300ER");
+}
+
+int Flight::layoutRowCount() {
+    return kRows;
+}
+
+QStringList Flight::layoutSeatLetters(int row) {
+    return row >= 1 && row <= kRows ? getSeatLettersForRow(row) : QStringList();
+}
+
+QString Flight::layoutSeatClass(int row) {
+    return seatClassForRow(row);
+}
+
 bool Flight::isSeatAvailable(const QString& seatNumber) const {
     auto it = seats.find(seatNumber);
     return it != seats.end() && it->second->isAvailable();
@@ -148,6 +291,8 @@ bool Flight::assignSeat(Passenger* passenger, const QString& seatNumber) {
     if (it == seats.end() || !it->second->isAvailable()) return false;
     if (it->second->setPassenger(passenger)) {
         passenger->setSeatNumber(seatNumber);
+        markDirty();
+        publish(ChangeEvent::Type::SeatBooked, seatNumber);
         return true;
     }
     return false;
@@ -157,6 +302,8 @@ bool Flight::unassignSeat(const QString& seatNumber) {
     if (!isSeatValid(seatNumber)) return false;
     auto it = seats.find(seatNumber);
     it->second->clearPassenger();
+    markDirty();
+    publish(ChangeEvent::Type::SeatReleased, seatNumber);
     return true;
 }
 
@@ -178,6 +325,8 @@ bool Flight::addPassenger(std::unique_ptr<Passenger> passenger) {
     if (!sn.isEmpty() && !assignSeat(passenger.get(), sn))
         return false;
     passengers.push_back(std::move(passenger));
+    markDirty();
+    publish(ChangeEvent::Type::PassengerAdded, sn);
     return true;
 }
 
@@ -188,6 +337,8 @@ bool Flight::removePassenger(const QString& seatNumber) {
     if (it == passengers.end()) return false;
     unassignSeat(seatNumber);
     passengers.erase(it);
+    markDirty();
+    publish(ChangeEvent::Type::PassengerRemoved, seatNumber);
     return true;
 }
 
@@ -285,24 +436,41 @@ QString Flight::generateSeatMap() const {
     return out;
 }
 
+Seat* Flight::getSeat(const QString& seatNumber) {
+    auto it = seats.find(seatNumber);
+    return it != seats.end() ? it->second.get() : nullptr;
+}
+
 bool Flight::reserveSeat(const QString& seatNumber) {
     auto it = seats.find(seatNumber);
-    return it != seats.end() && it->second->reserve();
+    if (it == seats.end() || !it->second->reserve()) return false;
+    markDirty();
+    publish(ChangeEvent::Type::SeatReserved, seatNumber);
+    return true;
 }
 
 bool Flight::cancelReservation(const QString& seatNumber) {
     auto it = seats.find(seatNumber);
-    return it != seats.end() && it->second->unreserve();
+    if (it == seats.end() || !it->second->unreserve()) return false;
+    markDirty();
+    publish(ChangeEvent::Type::SeatReservationCancelled, seatNumber);
+    return true;
 }
 
 bool Flight::blockSeat(const QString& seatNumber) {
     auto it = seats.find(seatNumber);
-    return it != seats.end() && it->second->block();
+    if (it == seats.end() || !it->second->block()) return false;
+    markDirty();
+    publish(ChangeEvent::Type::SeatBlocked, seatNumber);
+    return true;
 }
 
 bool Flight::unblockSeat(const QString& seatNumber) {
     auto it = seats.find(seatNumber);
-    return it != seats.end() && it->second->unblock();
+    if (it == seats.end() || !it->second->unblock()) return false;
+    markDirty();
+    publish(ChangeEvent::Type::SeatUnblocked, seatNumber);
+    return true;
 }
 
 double Flight::calculateRevenue() const {
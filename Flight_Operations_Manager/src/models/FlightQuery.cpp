@@ -0,0 +1,89 @@
+// This file contains the implementation for the `AirlineQuery` class,
+// which answers `FlightQuery` requests from the live `Airline` model.
+
+#include "models/FlightQuery.h"
+#include "models/Airline.h"
+
+namespace {
+    FlightSummary summarize(const Flight& flight) {
+        FlightSummary summary;
+        summary.flightNumber = flight.getFlightNumber();
+        summary.origin = flight.getOrigin();
+        summary.destination = flight.getDestination();
+        summary.departureTime = flight.getDepartureTime();
+        summary.passengerCount = flight.getPassengerCount();
+        summary.occupiedSeats = flight.getOccupiedSeats();
+        summary.totalSeats = static_cast<int>(flight.getSeats().size());
+        summary.revenue = flight.calculateRevenue();
+        return summary;
+    }
+
+    PassengerSummary summarize(const QString& flightNumber, const Passenger& passenger) {
+        return {flightNumber, passenger.getFirstName(), passenger.getLastName(),
+                passenger.getPhoneNumber(), passenger.getEmail(), passenger.getSeatNumber()};
+    }
+}
+
+int AirlineQuery::flightCount() const {
+    return static_cast<int>(airline.getFlights().size());
+}
+
+std::vector<FlightSummary> AirlineQuery::allFlights() const {
+    std::vector<FlightSummary> results;
+    results.reserve(airline.getFlights().size());
+    for (const auto& header : airline.getFlights()) {
+        if (const Flight* flight = airline.getFlight(header->getFlightNumber()))
+            results.push_back(summarize(*flight));
+    }
+    return results;
+}
+
+std::optional<FlightSummary> AirlineQuery::getFlight(const QString& flightNumber) const {
+    if (const Flight* flight = airline.getFlight(flightNumber))
+        return summarize(*flight);
+    return std::nullopt;
+}
+
+std::vector<FlightSummary> AirlineQuery::searchFlights(const QString& query) const {
+    std::vector<FlightSummary> results;
+    for (const Flight* match : airline.searchFlights(query)) {
+        if (const Flight* flight = airline.getFlight(match->getFlightNumber()))
+            results.push_back(summarize(*flight));
+    }
+    return results;
+}
+
+std::vector<PassengerSummary> AirlineQuery::searchPassengers(const QString& query) const {
+    std::vector<PassengerSummary> results;
+    for (const auto& header : airline.getFlights()) {
+        const Flight* flight = airline.getFlight(header->getFlightNumber());
+        if (!flight) continue;
+        for (const Passenger* passenger : flight->getAllPassengers()) {
+            if (passenger->getFirstName().contains(query, Qt::CaseInsensitive) ||
+                passenger->getLastName().contains(query, Qt::CaseInsensitive) ||
+                passenger->getPhoneNumber().contains(query)) {
+                results.push_back(summarize(flight->getFlightNumber(), *passenger));
+            }
+        }
+    }
+    return results;
+}
+
+std::vector<PassengerSummary> AirlineQuery::passengers(const QString& flightNumber) const {
+    std::vector<PassengerSummary> results;
+    if (const Flight* flight = airline.getFlight(flightNumber)) {
+        for (const Passenger* passenger : flight->getAllPassengers())
+            results.push_back(summarize(flightNumber, *passenger));
+    }
+    return results;
+}
+
+int AirlineQuery::occupiedSeats(const QString& flightNumber) const {
+    const Flight* flight = airline.getFlight(flightNumber);
+    return flight ? flight->getOccupiedSeats() : 0;
+}
+
+double AirlineQuery::revenue(const QString& flightNumber) const {
+    const Flight* flight = airline.getFlight(flightNumber);
+    return flight ? flight->calculateRevenue() : 0.0;
+}
@@ -0,0 +1,169 @@
+// This file contains the implementation for the `PassengerSearchIndex` class.
+// Names are compared against a case-folded copy of the arena, so each test is a
+// plain case-sensitive QStringView search; phone numbers match exactly as before.
+
+#include "models/PassengerSearchIndex.h"
+#include "models/Airline.h"
+#include <QHash>
+#include <QPromise>
+#include <QStringView>
+#include <algorithm>
+#include <limits>
+
+namespace {
+    // Small enough that the first batch arrives within a few milliseconds
+    constexpr quint32 kChunkSize = 16384;
+    constexpr qsizetype kMaxFieldLength = std::numeric_limits<quint16>::max();
+}
+
+std::shared_ptr<const PassengerSearchIndex> PassengerSearchIndex::build(const Airline& airline) {
+    auto index = std::make_shared<PassengerSearchIndex>();
+    index->position = airline.changeFeed().head();
+    index->segments.reserve(airline.getFlights().size());
+    index->firstEntry.reserve(airline.getFlights().size() + 1);
+    index->firstEntry.push_back(0);
+    for (const auto& flight : airline.getFlights())
+        index->append(copyFlight(*flight));
+    return index;
+}
+
+std::shared_ptr<const PassengerSearchIndex> PassengerSearchIndex::update(const Airline& airline,
+                                                                         const PassengerSearchIndex& previous,
+                                                                         const QSet<QString>& changed) {
+    QHash<QString, const std::shared_ptr<const Segment>*> reusable;
+    reusable.reserve(static_cast<qsizetype>(previous.segments.size()));
+    for (const auto& segment : previous.segments) {
+        if (!changed.contains(segment->flightNumber)) reusable.insert(segment->flightNumber, &segment);
+    }
+
+    auto index = std::make_shared<PassengerSearchIndex>();
+    index->position = airline.changeFeed().head();
+    index->segments.reserve(airline.getFlights().size());
+    index->firstEntry.reserve(airline.getFlights().size() + 1);
+    index->firstEntry.push_back(0);
+    for (const auto& flight : airline.getFlights()) {
+        // An unchanged flight keeps its segment even if it was evicted since
+        const auto* kept = reusable.value(flight->getFlightNumber());
+        index->append(kept ? *kept : copyFlight(*flight));
+    }
+    return index;
+}
+
+std::shared_ptr<const PassengerSearchIndex::Segment> PassengerSearchIndex::copyFlight(const Flight& flight) {
+    auto segment = std::make_shared<Segment>();
+    segment->flightNumber = flight.getFlightNumber();
+    const size_t count = flight.storedPassengerCount();
+    segment->entries.reserve(count);
+    segment->text.reserve(static_cast<qsizetype>(count * 24));
+    for (size_t i = 0; i < count; ++i) {
+        const Passenger* passenger = flight.storedPassenger(i);
+        const QString first = passenger->getFirstName().left(kMaxFieldLength);
+        const QString last = passenger->getLastName().left(kMaxFieldLength);
+        const QString phone = passenger->getPhoneNumber().left(kMaxFieldLength);
+        const QString seat = passenger->getSeatNumber().left(kMaxFieldLength);
+
+        Entry entry;
+        entry.start = static_cast<quint32>(segment->text.size());
+        entry.firstLength = static_cast<quint16>(first.size());
+        entry.lastLength = static_cast<quint16>(last.size());
+        entry.phoneLength = static_cast<quint16>(phone.size());
+        entry.seatLength = static_cast<quint16>(seat.size());
+        segment->text += first;
+        segment->text += last;
+        segment->text += phone;
+        segment->text += seat;
+        segment->entries.push_back(entry);
+    }
+    return segment;
+}
+
+void PassengerSearchIndex::append(std::shared_ptr<const Segment> segment) {
+    firstEntry.push_back(firstEntry.back() + static_cast<quint32>(segment->entries.size()));
+    segments.push_back(std::move(segment));
+}
+
+std::pair<const PassengerSearchIndex::Segment*, const PassengerSearchIndex::Entry*>
+PassengerSearchIndex::locate(quint32 entry) const {
+    // firstEntry is sorted; the segment is the last one starting at or before `entry`
+    const auto next = std::upper_bound(firstEntry.begin(), firstEntry.end(), entry);
+    const size_t s = static_cast<size_t>(next - firstEntry.begin()) - 1;
+    const Segment* segment = segments[s].get();
+    return {segment, &segment->entries[entry - firstEntry[s]]};
+}
+
+QString PassengerSearchIndex::firstName(quint32 i) const {
+    const auto [segment, e] = locate(i);
+    return segment->field(e->start, e->firstLength);
+}
+
+QString PassengerSearchIndex::lastName(quint32 i) const {
+    const auto [segment, e] = locate(i);
+    return segment->field(e->start + e->firstLength, e->lastLength);
+}
+
+QString PassengerSearchIndex::phoneNumber(quint32 i) const {
+    const auto [segment, e] = locate(i);
+    return segment->field(e->start + e->firstLength + e->lastLength, e->phoneLength);
+}
+
+QString PassengerSearchIndex::seatNumber(quint32 i) const {
+    const auto [segment, e] = locate(i);
+    return segment->field(e->start + e->firstLength + e->lastLength + e->phoneLength, e->seatLength);
+}
+
+QString PassengerSearchIndex::flightNumber(quint32 i) const {
+    return locate(i).first->flightNumber;
+}
+
+void PassengerSearchIndex::Segment::fold() const {
+    std::call_once(foldOnce, [this] {
+        folded = text;
+        for (QChar& c : folded) c = c.toCaseFolded();
+    });
+}
+
+void PassengerSearchIndex::search(QPromise<Batch>& promise, const QString& query) const {
+    if (query.isEmpty()) return;
+
+    QString foldedQuery = query;
+    for (QChar& c : foldedQuery) c = c.toCaseFolded();
+    const QStringView needle(foldedQuery);
+
+    // Flights are scanned whole; a batch is sent once a chunk's worth of entries is done
+    Batch batch;
+    quint32 scanned = 0;
+    auto flush = [&] {
+        if (!batch.isEmpty()) {
+            std::stable_sort(batch.begin(), batch.end(),
+                             [](const Match& a, const Match& b) { return a.rank < b.rank; });
+            promise.addResult(batch);
+            batch.clear();
+        }
+        scanned = 0;
+    };
+
+    for (size_t s = 0; s < segments.size(); ++s) {
+        if (promise.isCanceled()) return;
+
+        const Segment& segment = *segments[s];
+        segment.fold();
+        const QStringView names(segment.folded);
+        const QStringView original(segment.text);
+        const quint32 base = firstEntry[s];
+        for (quint32 i = 0; i < segment.entries.size(); ++i) {
+            const Entry& e = segment.entries[i];
+            const QStringView first = names.sliced(e.start, e.firstLength);
+            const QStringView last = names.sliced(e.start + e.firstLength, e.lastLength);
+            if (first.startsWith(needle) || last.startsWith(needle)) {
+                batch.append({base + i, NamePrefix});
+            } else if (first.contains(needle) || last.contains(needle)) {
+                batch.append({base + i, NameSubstring});
+            } else if (original.sliced(e.start + e.firstLength + e.lastLength, e.phoneLength).contains(query)) {
+                batch.append({base + i, PhoneSubstring});
+            }
+        }
+        scanned += static_cast<quint32>(segment.entries.size());
+        if (scanned >= kChunkSize) flush();
+    }
+    if (!promise.isCanceled()) flush();
+}